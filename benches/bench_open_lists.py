@@ -0,0 +1,48 @@
+import sys, math, pathlib, time, statistics
+
+build = pathlib.Path(__file__).resolve().parents[1] / "build/python_package"
+if build.exists():
+    sys.path.insert(0, str(build))
+
+from astar_py import Mesh, OpenListKind, SearchOptions, euclidian_heuristics, make_vertex_graph, find_best_path
+
+def make_grid_mesh(size: int) -> Mesh:
+    mesh = Mesh()
+    mesh.vertices = [(float(x), float(y), 0.3 * math.sin(0.7 * (y * size + x))) for y in range(size) for x in range(size)]
+    faces = []
+    for y in range(size - 1):
+        for x in range(size - 1):
+            c = y * size + x
+            faces.append((c, c + 1, c + size + 1))
+            faces.append((c, c + size + 1, c + size))
+    mesh.faces = faces
+    return mesh
+
+def bench(graph, heuristics, ends, options, repeats: int) -> float:
+    timings = []
+    for _ in range(repeats):
+        start = time.perf_counter()
+        find_best_path(graph, heuristics, ends, options=options)
+        timings.append(time.perf_counter() - start)
+    return statistics.median(timings)
+
+KINDS = (OpenListKind.binary_heap, OpenListKind.quaternary_heap, OpenListKind.pairing_heap,
+         OpenListKind.radix_heap, OpenListKind.quantized_radix_heap)
+
+if __name__ == "__main__":
+    sizes = [int(arg) for arg in sys.argv[1:]] or [100, 300, 1000]
+    repeats = 5
+    heuristics = euclidian_heuristics()
+    for size in sizes:
+        graph = make_vertex_graph(make_grid_mesh(size))
+        ends = (0, size * size - 1)
+        timings = {}
+        for kind in KINDS:
+            options = SearchOptions()
+            options.open_list = kind
+            timings[kind] = bench(graph, heuristics, ends, options, repeats)
+        best = min(timings, key=timings.get)
+        print(f"{size}x{size} grid ({size * size} vertices):")
+        for kind, elapsed in timings.items():
+            marker = " <- fastest" if kind == best else ""
+            print(f"  {kind.name:<21} {elapsed * 1e3:8.2f} ms{marker}")
@@ -0,0 +1,40 @@
+import sys, pathlib, time, statistics
+
+build = pathlib.Path(__file__).resolve().parents[1] / "build/python_package"
+if build.exists():
+    sys.path.insert(0, str(build))
+
+from astar_py import Mesh, euclidian_heuristics, make_vertex_graph, find_best_path, parallel_options, optimal_options
+
+def make_grid_mesh(size: int) -> Mesh:
+    mesh = Mesh()
+    mesh.vertices = [(float(x), float(y), 0.0) for y in range(size) for x in range(size)]
+    faces = []
+    for y in range(size - 1):
+        for x in range(size - 1):
+            c = y * size + x
+            faces.append((c, c + 1, c + size + 1))
+            faces.append((c, c + size + 1, c + size))
+    mesh.faces = faces
+    return mesh
+
+def bench(graph, heuristics, ends, options, repeats: int) -> float:
+    timings = []
+    for _ in range(repeats):
+        start = time.perf_counter()
+        find_best_path(graph, heuristics, ends, options=options)
+        timings.append(time.perf_counter() - start)
+    return statistics.median(timings)
+
+if __name__ == "__main__":
+    size = int(sys.argv[1]) if len(sys.argv) > 1 else 1000
+    repeats = int(sys.argv[2]) if len(sys.argv) > 2 else 3
+    graph = make_vertex_graph(make_grid_mesh(size))
+    heuristics = euclidian_heuristics()
+    ends = (0, size * size - 1)
+
+    reference = bench(graph, heuristics, ends, optimal_options(), repeats)
+    print(f"{size}x{size} grid, sequential A*: {reference * 1e3:.1f} ms")
+    for threads in (4, 8, 16, 32):
+        elapsed = bench(graph, heuristics, ends, parallel_options(threads), repeats)
+        print(f"HDA* {threads:>2} threads: {elapsed * 1e3:.1f} ms (x{reference / elapsed:.2f})")
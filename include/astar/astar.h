@@ -2,9 +2,11 @@
 
 #include <variant>
 
+#include "components.h"
 #include "mesh.h"
 #include "path.h"
 #include "heuristics.h"
+#include "search_options.h"
 
 namespace astar {
 
@@ -25,16 +27,24 @@ private:
 
     const Mesh& mesh;
     const Heuristics& heuristics;
+    const ComponentLabels* components;
     bool retrieve_vertices;
+    SearchOptions options;
+
+    Path unreachable() const;
 
 public:
 
-    FindBestPath(const Mesh& m, const Heuristics& h, const bool retrieve_vertices);
+    FindBestPath(const Mesh& m, const Heuristics& h, const bool retrieve_vertices, const SearchOptions& options=SearchOptions{ });
+    FindBestPath(const Mesh& m, const Heuristics& h, const ComponentLabels& c, const bool retrieve_vertices, const SearchOptions& options=SearchOptions{ });
     Path operator()(const std::pair<std::size_t, std::size_t>& ends) const;
     Path operator()(const std::pair<Barycenter, Barycenter>& ends) const;
 
 };
 
-Path find_best_path(const Mesh& mesh, const Heuristics& heuristics, const Ends& ends, const bool retrive_vertices=false);
+Path find_best_path(const Mesh& mesh, const Heuristics& heuristics, const Ends& ends, const bool retrive_vertices=false, const SearchOptions& options=SearchOptions{ });
+
+// Rejects ends lying in different islands in O(1) before any graph is built.
+Path find_best_path(const Mesh& mesh, const Heuristics& heuristics, const ComponentLabels& components, const Ends& ends, const bool retrive_vertices=false, const SearchOptions& options=SearchOptions{ });
 
 } // namespace astar
\ No newline at end of file
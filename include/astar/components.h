@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+
+#include "vertex.h"
+#include "face.h"
+#include "mesh.h"
+
+namespace astar {
+
+// Component label of every node, labels numbered 0..k-1 in order of first appearance.
+using Components = std::vector<std::size_t>;
+
+struct ComponentLabels {
+
+    Components vertices;
+    Components faces;
+
+};
+
+namespace ComponentsFactory {
+
+// Islands of the graph built by ConnectivityMapFactory::make_vertex_to_vertex.
+Components make_vertex_components(const Vertices& vertices, const Faces& faces, const std::size_t threads=0);
+
+// Islands of the graph built by ConnectivityMapFactory::make_face_to_face.
+Components make_face_components(const Faces& faces, const std::size_t threads=0);
+
+ComponentLabels make(const Mesh& mesh, const std::size_t threads=0);
+
+} // namespace astar::ComponentsFactory
+
+} // namespace astar
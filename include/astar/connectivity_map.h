@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory_resource>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -8,13 +9,17 @@
 
 namespace astar {
 
-using ConnectivityMap = std::unordered_map<std::size_t, std::unordered_set<std::size_t>>;
+using Neighbors = std::pmr::unordered_set<std::size_t>;
+
+using ConnectivityMap = std::pmr::unordered_map<std::size_t, Neighbors>;
 
 namespace ConnectivityMapFactory {
 
-ConnectivityMap make_vertex_to_vertex(const Vertices& vertices, const Faces& faces);
+// The map, its neighbor sets and every intermediate table are allocated from resource,
+// which must outlive the returned map.
+ConnectivityMap make_vertex_to_vertex(const Vertices& vertices, const Faces& faces, std::pmr::memory_resource* resource=std::pmr::get_default_resource());
 
-ConnectivityMap make_face_to_face(const Faces& faces);
+ConnectivityMap make_face_to_face(const Faces& faces, std::pmr::memory_resource* resource=std::pmr::get_default_resource());
 
 } // // namespace astar::ConnectivityMapFactory
 
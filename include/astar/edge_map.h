@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <memory_resource>
 #include <unordered_map>
 
 #include "vertex.h"
@@ -26,13 +27,13 @@ struct EdgeHash {
 
 };
 
-using EdgeMap = std::unordered_map<Edge, float, EdgeHash, EdgeEqual>;
+using EdgeMap = std::pmr::unordered_map<Edge, float, EdgeHash, EdgeEqual>;
 
 std::array<Edge, 3> face_edges(const Face& face);
 
 namespace EdgeMapFactory {
 
-EdgeMap make(const Vertices& vertices, const Faces& faces);
+EdgeMap make(const Vertices& vertices, const Faces& faces, std::pmr::memory_resource* resource=std::pmr::get_default_resource());
 
 } // namespace astar::EdgeMapFactory
 
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "astar.h"
+#include "mesh.h"
+#include "path.h"
+
+namespace astar {
+
+namespace detail {
+
+struct HeatSystem;
+
+} // namespace astar::detail
+
+// Geodesic distances with the heat method (Crane, Weischedel, Wardetzky): heat diffused from
+// the sources for a short time gives the direction of the distance gradient, and a Poisson
+// equation recovers the distance from it. The heat and Poisson operators (cotangent Laplacian,
+// lumped mass) are assembled and Cholesky-factored once; each source set then costs two pairs
+// of triangular solves.
+class HeatGeodesics {
+
+private:
+
+    std::shared_ptr<const detail::HeatSystem> system;
+
+public:
+
+    // time_scale multiplies the diffusion time h^2 (h the mean edge length); larger values
+    // smooth the field, smaller ones follow the mesh more closely.
+    explicit HeatGeodesics(const Mesh& mesh, const std::size_t threads=0, const float time_scale=1.f);
+
+    // Approximate distance from every vertex to the closest source, infinity for vertices
+    // that no source can reach.
+    std::vector<float> distances(const std::vector<std::size_t>& sources) const;
+
+    // One distance field per source set, the sets solved in parallel.
+    std::vector<std::vector<float>> batch_distances(const std::vector<std::vector<std::size_t>>& source_sets) const;
+
+    // Steepest descent of the distance field from start down to a source: vertices holds the
+    // polyline, which crosses faces instead of following edges, and steps the faces crossed.
+    // Steps are empty when start cannot reach any source.
+    Path trace(const std::vector<float>& distances, const std::size_t start) const;
+    Path trace(const std::vector<float>& distances, const Barycenter& start) const;
+
+};
+
+} // namespace astar
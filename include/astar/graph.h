@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory_resource>
+#include <utility>
+
+#include "connectivity_map.h"
+#include "heuristics.h"
+#include "mesh.h"
+#include "path.h"
+#include "path_buffers.h"
+#include "search_options.h"
+
+namespace astar {
+
+// Adjacency prepared once and searched many times: nodes are either the mesh vertices
+// or the mesh faces, the latter positioned at their centroids.
+struct Graph {
+
+    Vertices positions;
+    ConnectivityMap connectivity;
+
+};
+
+namespace GraphFactory {
+
+// The adjacency is allocated from resource, which must outlive the graph.
+Graph make_vertex_graph(const Mesh& mesh, std::pmr::memory_resource* resource=std::pmr::get_default_resource());
+
+Graph make_face_graph(const Mesh& mesh, std::pmr::memory_resource* resource=std::pmr::get_default_resource());
+
+} // namespace astar::GraphFactory
+
+Path find_best_path(const Graph& graph, const Heuristics& heuristics, const std::pair<std::size_t, std::size_t>& ends, const bool retrieve_vertices=false, const SearchOptions& options=SearchOptions{ });
+
+// Allocation-free variants: steps are written straight into path.steps, and path.vertices is
+// only filled when retrieve_vertices is set (fill_vertices can do it later on demand).
+void find_best_path(const Graph& graph, const Heuristics& heuristics, const std::pair<std::size_t, std::size_t>& ends, PathBuffers<std::size_t>& path, const bool retrieve_vertices=false, const SearchOptions& options=SearchOptions{ });
+
+void find_best_path(const Graph& graph, const Heuristics& heuristics, const std::pair<std::size_t, std::size_t>& ends, PathBuffers<std::uint32_t>& path, const bool retrieve_vertices=false, const SearchOptions& options=SearchOptions{ });
+
+void fill_vertices(const Graph& graph, const std::vector<std::size_t>& steps, Vertices& vertices);
+
+void fill_vertices(const Graph& graph, const std::vector<std::uint32_t>& steps, Vertices& vertices);
+
+} // namespace astar
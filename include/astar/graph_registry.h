@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "astar.h"
+#include "components.h"
+#include "graph.h"
+#include "mesh.h"
+
+namespace astar {
+
+// Immutable state served by a GraphRegistry: a mesh with its prepared vertex and face graphs
+// and island labels. Version 0 is the empty snapshot a registry starts with.
+struct GraphSnapshot {
+
+    std::uint64_t version;
+    Mesh mesh;
+    Graph vertex_graph;
+    Graph face_graph;
+    ComponentLabels components;
+
+};
+
+class GraphRegistry;
+
+// Pins the snapshot that was current when it was acquired: it stays valid until the lease is
+// destroyed, whatever gets published meanwhile.
+class SnapshotLease {
+
+private:
+
+    const GraphRegistry* registry;
+    std::size_t slot;
+    const GraphSnapshot* snapshot;
+
+public:
+
+    SnapshotLease(const GraphRegistry& registry, const std::size_t slot, const GraphSnapshot* snapshot);
+    SnapshotLease(SnapshotLease&& other) noexcept;
+    SnapshotLease(const SnapshotLease&) = delete;
+    SnapshotLease& operator=(const SnapshotLease&) = delete;
+    SnapshotLease& operator=(SnapshotLease&&) = delete;
+    ~SnapshotLease();
+
+    const GraphSnapshot& operator*() const;
+    const GraphSnapshot* operator->() const;
+
+};
+
+// Hot-swappable graphs with epoch-based reclamation (RCU). Readers announce the epoch they
+// enter in a slot of their own and read the current snapshot without taking any lock; an
+// update is built off to the side, then swapped in atomically. A replaced snapshot is
+// destroyed once every reader that entered before the swap has released its lease.
+class GraphRegistry {
+
+private:
+
+    friend class SnapshotLease;
+
+    static constexpr auto reader_slots = std::size_t{ 128 };
+    static constexpr auto idle_slot = std::numeric_limits<std::uint64_t>::max();
+
+    struct alignas(64) ReaderSlot {
+
+        std::atomic<std::uint64_t> epoch{ idle_slot };
+
+    };
+
+    std::size_t threads;
+
+    mutable std::array<ReaderSlot, reader_slots> readers;
+    std::atomic<std::uint64_t> epoch;
+    std::atomic<const GraphSnapshot*> current;
+
+    std::mutex publish_mutex;
+    mutable std::mutex retired_mutex;
+    mutable std::vector<std::pair<std::uint64_t, const GraphSnapshot*>> retired;
+    mutable std::atomic<bool> has_retired;
+
+    std::mutex queue_mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::optional<Mesh> pending;
+    std::exception_ptr failure;
+    bool busy;
+    bool stopping;
+    std::thread worker;
+
+    void run();
+    std::uint64_t oldest_reader() const;
+    void release(const std::size_t slot) const;
+    void reclaim(std::unique_lock<std::mutex>& lock) const;
+
+public:
+
+    explicit GraphRegistry(const std::size_t threads=0);
+    GraphRegistry(const GraphRegistry&) = delete;
+    GraphRegistry& operator=(const GraphRegistry&) = delete;
+    ~GraphRegistry();
+
+    // Builds the graphs of mesh on the calling thread and publishes them; returns the new version.
+    std::uint64_t update(Mesh mesh);
+    // Same on the background thread; a pending request is replaced by a newer one.
+    void request_update(Mesh mesh);
+    void wait_idle();
+
+    SnapshotLease acquire() const;
+    std::uint64_t version() const;
+    // Replaced snapshots still pinned by a reader; unpinned ones are freed by a later release or update.
+    std::size_t retired_snapshots() const;
+
+};
+
+// Runs the query on the snapshot current when the call starts: vertex pairs on the vertex
+// graph, barycenter pairs on the face graph, islands rejected up front.
+Path find_best_path(const GraphRegistry& registry, const Heuristics& heuristics, const Ends& ends, const bool retrieve_vertices=false, const SearchOptions& options=SearchOptions{ });
+
+} // namespace astar
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace astar {
+
+// Ready-made resources for graph builds and searches (see SearchOptions::resource and the
+// resource argument of the graph factories). None of them is shared between threads unless
+// stated: give each worker its own.
+namespace MemoryResourceFactory {
+
+// Bump allocator: deallocation is a no-op and release() frees a whole build or query at once.
+std::unique_ptr<std::pmr::monotonic_buffer_resource> make_arena(const std::size_t initial_size=std::size_t{ 1u << 20 }, std::pmr::memory_resource* upstream=std::pmr::get_default_resource());
+
+// Size-class pools, suited to graphs that are rebuilt often and live for a while.
+std::unique_ptr<std::pmr::unsynchronized_pool_resource> make_pool(std::pmr::memory_resource* upstream=std::pmr::get_default_resource());
+
+// Thread-safe pools, for a resource shared by concurrent builds or queries.
+std::unique_ptr<std::pmr::synchronized_pool_resource> make_shared_pool(std::pmr::memory_resource* upstream=std::pmr::get_default_resource());
+
+} // namespace astar::MemoryResourceFactory
+
+} // namespace astar
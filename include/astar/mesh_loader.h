@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+
+#include "mesh.h"
+
+namespace astar {
+
+// Native OBJ / PLY readers. Files are memory mapped and parsed in parallel chunks
+// (threads = 0 uses every hardware thread); polygons are fan-triangulated and
+// vertices sharing the same position are welded.
+namespace MeshLoader {
+
+Mesh load_obj(const std::string& path, const std::size_t threads=0);
+
+Mesh load_ply(const std::string& path, const std::size_t threads=0);
+
+Mesh load(const std::string& path, const std::size_t threads=0);
+
+} // namespace astar::MeshLoader
+
+} // namespace astar
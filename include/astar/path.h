@@ -12,6 +12,8 @@ struct Path {
 
     std::vector<std::size_t> steps;
     std::optional<Vertices> vertices;
+    float suboptimality{ 1.f };
+    std::size_t expansions{ 0 };
 
 };
 
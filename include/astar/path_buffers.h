@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "vertex.h"
+
+namespace astar {
+
+namespace detail {
+
+class SearchScratch;
+
+// Owns the search state that successive queries writing into the same buffers reuse.
+// Copies start empty, so two copies never share state across threads.
+class ScratchHandle {
+
+private:
+
+    std::unique_ptr<SearchScratch, void(*)(SearchScratch*)> scratch;
+
+public:
+
+    ScratchHandle();
+    ScratchHandle(const ScratchHandle&);
+    ScratchHandle(ScratchHandle&&) noexcept = default;
+    ScratchHandle& operator=(const ScratchHandle&);
+    ScratchHandle& operator=(ScratchHandle&&) noexcept = default;
+    ~ScratchHandle() = default;
+
+    SearchScratch& get();
+
+};
+
+} // namespace astar::detail
+
+// Caller-owned query output. Searches clear the buffers without releasing them, so once
+// warmed up a buffer reused across queries costs no allocation. Index may be std::uint32_t
+// to halve the size of the steps on graphs below 2^32 nodes. Sequential searches also keep
+// their per-node state here, so a query only pays for the nodes it touches; the memory
+// resource of the options must then outlive the buffers.
+template<typename Index>
+struct PathBuffers {
+
+    std::vector<Index> steps;
+    Vertices vertices;
+    float suboptimality{ 1.f };
+    std::size_t expansions{ 0 };
+    detail::ScratchHandle scratch{ };
+
+};
+
+using CompactPathBuffers = PathBuffers<std::uint32_t>;
+
+} // namespace astar
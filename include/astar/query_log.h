@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "astar.h"
+#include "mesh.h"
+
+namespace astar {
+
+// FNV-1a over vertex coordinates and face indices, used to match a log with its mesh.
+std::uint64_t mesh_hash(const Mesh& mesh);
+
+struct QueryLog {
+
+    std::uint64_t mesh_hash;
+    std::vector<Ends> queries;
+
+};
+
+// Appends queries to a compact little-endian binary log: a header carrying the mesh hash,
+// then one record per query (9 bytes for vertex pairs, 33 for barycenter pairs).
+// record() may be called from several threads.
+class QueryRecorder {
+
+private:
+
+    std::mutex mutex;
+    std::ofstream stream;
+
+public:
+
+    QueryRecorder(const std::string& path, const Mesh& mesh);
+    void record(const Ends& ends);
+    void flush();
+
+};
+
+namespace QueryLogLoader {
+
+QueryLog load(const std::string& path);
+
+} // namespace astar::QueryLogLoader
+
+} // namespace astar
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory_resource>
+#include <vector>
+
+#include "graph.h"
+
+namespace astar {
+
+// Nodes settled by a bounded Dijkstra in order of increasing cost: nodes[i] lies at cost
+// costs[i] (sum of edge lengths) from the nearest source.
+struct Reach {
+
+    std::vector<std::uint32_t> nodes;
+    std::vector<float> costs;
+
+};
+
+using NodePredicate = std::function<bool(std::size_t)>;
+
+constexpr auto unbounded_cost = std::numeric_limits<float>::infinity();
+
+// The Dijkstra state (costs, open list, target mask) is drawn from resource; nullptr means the
+// default resource. Batch workers reach it through a synchronized pool, one call at a time.
+
+// Every node within max_cost of a source, the sources included.
+Reach find_within(const Graph& graph, const std::vector<std::size_t>& sources, const float max_cost, std::pmr::memory_resource* resource=nullptr);
+
+// The count nodes closest to the sources among those accepted by is_target (or listed in
+// targets), within max_cost; the search stops as soon as the last one is settled.
+Reach find_nearest(const Graph& graph, const std::vector<std::size_t>& sources, const NodePredicate& is_target, const std::size_t count=1, const float max_cost=unbounded_cost, std::pmr::memory_resource* resource=nullptr);
+
+Reach find_nearest(const Graph& graph, const std::vector<std::size_t>& sources, const std::vector<std::size_t>& targets, const std::size_t count=1, const float max_cost=unbounded_cost, std::pmr::memory_resource* resource=nullptr);
+
+// One query per source, spread over threads (0: all cores). is_target is called concurrently.
+std::vector<Reach> batch_find_within(const Graph& graph, const std::vector<std::size_t>& sources, const float max_cost, const std::size_t threads=0, std::pmr::memory_resource* resource=nullptr);
+
+std::vector<Reach> batch_find_nearest(const Graph& graph, const std::vector<std::size_t>& sources, const NodePredicate& is_target, const std::size_t count=1, const float max_cost=unbounded_cost, const std::size_t threads=0, std::pmr::memory_resource* resource=nullptr);
+
+std::vector<Reach> batch_find_nearest(const Graph& graph, const std::vector<std::size_t>& sources, const std::vector<std::size_t>& targets, const std::size_t count=1, const float max_cost=unbounded_cost, const std::size_t threads=0, std::pmr::memory_resource* resource=nullptr);
+
+} // namespace astar
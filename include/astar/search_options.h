@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <memory_resource>
+#include <optional>
+
+namespace astar {
+
+// Priority queue of the sequential search. The radix heaps assume monotone keys (consistent
+// heuristics at epsilon = 1), so weighted and anytime searches fall back to binary_heap; the
+// quantized one rounds keys to key_quantum. With either, Path::suboptimality is the bound
+// proven from the open list.
+enum class OpenListKind {
+
+    binary_heap,
+    quaternary_heap,
+    pairing_heap,
+    radix_heap,
+    quantized_radix_heap
+
+};
+
+struct SearchOptions {
+
+    float epsilon{ 1.f };
+    float epsilon_step{ 0.5f };
+    std::optional<std::chrono::microseconds> time_budget{ std::nullopt };
+    std::size_t threads{ 1 };
+    // Backs the search state (costs, parents, open list); nullptr means the default resource.
+    // Parallel searches reach it through a synchronized pool, never from two threads at once.
+    std::pmr::memory_resource* resource{ nullptr };
+    OpenListKind open_list{ OpenListKind::binary_heap };
+    float key_quantum{ 1e-3f };
+
+};
+
+namespace SearchOptionsFactory {
+
+SearchOptions make_optimal();
+
+SearchOptions make_weighted(const float epsilon);
+
+SearchOptions make_anytime(const float epsilon, const std::chrono::microseconds time_budget, const float epsilon_step=0.5f);
+
+// Hash-distributed A* over several threads; anytime budgets are ignored by this mode.
+SearchOptions make_parallel(const std::size_t threads, const float epsilon=1.f);
+
+} // namespace astar::SearchOptionsFactory
+
+} // namespace astar
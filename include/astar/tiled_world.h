@@ -0,0 +1,99 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "astar.h"
+#include "mesh.h"
+
+namespace astar {
+
+// A piece of a larger world. Tiles index their own vertices and faces locally;
+// vertex_ids / face_ids give the world index of each of them, and vertices shared
+// with neighbor tiles carry the same world index on both sides.
+struct Tile {
+
+    Mesh mesh;
+    std::vector<std::size_t> vertex_ids;
+    std::vector<std::size_t> face_ids;
+
+};
+
+using TileLoader = std::function<Tile(const std::size_t tile)>;
+
+namespace detail {
+
+struct Residents;
+
+} // namespace astar::detail
+
+// Set of resident tiles, each with its own prepared adjacency and portal tables
+// linking its boundary to the neighbor tiles. Loads and evictions publish a new
+// immutable snapshot; queries keep the snapshot they started on alive.
+class TiledWorld {
+
+private:
+
+    TileLoader loader;
+
+    mutable std::mutex residents_mutex;
+    std::shared_ptr<const detail::Residents> residents;
+    std::mutex publish_mutex;
+
+    std::mutex queue_mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::deque<std::pair<bool, std::size_t>> requests;
+    std::exception_ptr failure;
+    bool busy;
+    bool stopping;
+    std::thread worker;
+
+    void run();
+    void enqueue(const bool load, const std::size_t tile);
+
+public:
+
+    explicit TiledWorld(TileLoader loader);
+    TiledWorld(const TiledWorld&) = delete;
+    TiledWorld& operator=(const TiledWorld&) = delete;
+    ~TiledWorld();
+
+    void load(const std::size_t tile);
+    void evict(const std::size_t tile);
+    void request_load(const std::size_t tile);
+    void request_evict(const std::size_t tile);
+    void wait_idle();
+
+    bool is_resident(const std::size_t tile) const;
+    std::vector<std::size_t> resident_tiles() const;
+    std::shared_ptr<const detail::Residents> snapshot() const;
+
+};
+
+class FindTiledPath {
+
+private:
+
+    std::shared_ptr<const detail::Residents> residents;
+    const Heuristics& heuristics;
+    bool retrieve_vertices;
+    SearchOptions options;
+
+public:
+
+    FindTiledPath(const TiledWorld& w, const Heuristics& h, const bool retrieve_vertices, const SearchOptions& options=SearchOptions{ });
+    Path operator()(const std::pair<std::size_t, std::size_t>& ends) const;
+    Path operator()(const std::pair<Barycenter, Barycenter>& ends) const;
+
+};
+
+Path find_best_path(const TiledWorld& world, const Heuristics& heuristics, const Ends& ends, const bool retrieve_vertices=false, const SearchOptions& options=SearchOptions{ });
+
+} // namespace astar
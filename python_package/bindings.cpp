@@ -5,13 +5,22 @@
 #include <nanobind/stl/variant.h>
 #include <nanobind/stl/pair.h>
 #include <nanobind/stl/function.h>
+#include <nanobind/stl/chrono.h>
+#include <nanobind/stl/string.h>
 
 #include "astar/vertex.h"
 #include "astar/face.h"
 #include "astar/path.h"
 #include "astar/mesh.h"
+#include "astar/mesh_loader.h"
 #include "astar/heuristics.h"
+#include "astar/search_options.h"
 #include "astar/astar.h"
+#include "astar/components.h"
+#include "astar/graph.h"
+#include "astar/geodesics.h"
+#include "astar/graph_registry.h"
+#include "astar/range_query.h"
 
 namespace nb = nanobind;
 using namespace nb::literals;
@@ -33,11 +42,59 @@ NB_MODULE(astar_py, m) {
         .def(nb::init<>())
         .def_rw("distance", &astar::Heuristics::distance);
 
+    // Heuristique native : appelable depuis plusieurs threads sans reprendre le GIL
+    m.def("euclidian_heuristics", &astar::HeuristicsFactory::make_euclidian,
+          "Distance euclidienne implémentée en C++");
+
     // astar::Path (résultat)
     nb::class_<astar::Path>(m, "Path")
         .def(nb::init<>())
         .def_rw("steps",    &astar::Path::steps)     // vector<size_t>
-        .def_rw("vertices", &astar::Path::vertices); // optional<Vertices>
+        .def_rw("vertices", &astar::Path::vertices)  // optional<Vertices>
+        .def_rw("suboptimality", &astar::Path::suboptimality)
+        .def_rw("expansions", &astar::Path::expansions);    // nœuds développés
+
+    // File de priorité de la recherche séquentielle (politique choisie à la compilation)
+    nb::enum_<astar::OpenListKind>(m, "OpenListKind")
+        .value("binary_heap",          astar::OpenListKind::binary_heap)
+        .value("quaternary_heap",      astar::OpenListKind::quaternary_heap)
+        .value("pairing_heap",         astar::OpenListKind::pairing_heap)
+        .value("radix_heap",           astar::OpenListKind::radix_heap)
+        .value("quantized_radix_heap", astar::OpenListKind::quantized_radix_heap);
+
+    nb::class_<astar::SearchOptions>(m, "SearchOptions")
+        .def(nb::init<>())
+        .def_rw("epsilon",      &astar::SearchOptions::epsilon)
+        .def_rw("epsilon_step", &astar::SearchOptions::epsilon_step)
+        .def_rw("time_budget",  &astar::SearchOptions::time_budget)
+        .def_rw("threads",      &astar::SearchOptions::threads)
+        .def_rw("open_list",    &astar::SearchOptions::open_list)
+        .def_rw("key_quantum",  &astar::SearchOptions::key_quantum);
+
+    m.def("optimal_options", &astar::SearchOptionsFactory::make_optimal,
+          "A* optimal (epsilon = 1)");
+
+    m.def("weighted_options", &astar::SearchOptionsFactory::make_weighted,
+          "epsilon"_a,
+          "A* pondéré : coût du chemin <= epsilon * optimal");
+
+    m.def("anytime_options", &astar::SearchOptionsFactory::make_anytime,
+          "epsilon"_a, "time_budget"_a, "epsilon_step"_a = 0.5f,
+          "ARA* : première solution à epsilon, puis amélioration jusqu'à épuisement du budget");
+
+    m.def("parallel_options", &astar::SearchOptionsFactory::make_parallel,
+          "threads"_a, "epsilon"_a = 1.f,
+          "HDA* : une requête répartie sur plusieurs threads");
+
+    // Graphe préparé une fois, interrogé plusieurs fois
+    nb::class_<astar::Graph>(m, "Graph")
+        .def_ro("positions", &astar::Graph::positions);
+
+    m.def("make_vertex_graph", [](const astar::Mesh& mesh) { return astar::GraphFactory::make_vertex_graph(mesh); },
+          "mesh"_a, nb::call_guard<nb::gil_scoped_release>());
+
+    m.def("make_face_graph", [](const astar::Mesh& mesh) { return astar::GraphFactory::make_face_graph(mesh); },
+          "mesh"_a, nb::call_guard<nb::gil_scoped_release>());
 
     // Aides pour construire un astar::Ends côté Python (facultatif mais pratique)
     m.def("vertex_ends",
@@ -54,13 +111,105 @@ NB_MODULE(astar_py, m) {
           "A"_a, "B"_a,
           "Crée un Ends défini par deux barycentres");
 
+    // Composantes connexes : étiquettes par sommet et par face
+    nb::class_<astar::ComponentLabels>(m, "ComponentLabels")
+        .def(nb::init<>())
+        .def_rw("vertices", &astar::ComponentLabels::vertices)
+        .def_rw("faces",    &astar::ComponentLabels::faces);
+
+    m.def("make_components", &astar::ComponentsFactory::make,
+          "mesh"_a, "threads"_a = 0, nb::call_guard<nb::gil_scoped_release>(),
+          "Étiquette les îlots des graphes sommet-sommet et face-face (union-find parallèle)");
+
+    // Chargement natif (mmap + parsing parallèle), le GIL est relâché pendant la lecture
+    m.def("load_mesh", &astar::MeshLoader::load,
+          "path"_a, "threads"_a = 0, nb::call_guard<nb::gil_scoped_release>(),
+          "Charge un fichier .obj ou .ply (threads = 0 : tous les coeurs)");
+
+    m.def("load_obj", &astar::MeshLoader::load_obj,
+          "path"_a, "threads"_a = 0, nb::call_guard<nb::gil_scoped_release>(),
+          "Charge un fichier Wavefront OBJ");
+
+    m.def("load_ply", &astar::MeshLoader::load_ply,
+          "path"_a, "threads"_a = 0, nb::call_guard<nb::gil_scoped_release>(),
+          "Charge un fichier PLY ascii ou binaire");
+
+    // Distances géodésiques (méthode de la chaleur), factorisées une fois par maillage
+    nb::class_<astar::HeatGeodesics>(m, "HeatGeodesics")
+        .def(nb::init<const astar::Mesh&, const std::size_t, const float>(),
+             "mesh"_a, "threads"_a = 0, "time_scale"_a = 1.f, nb::call_guard<nb::gil_scoped_release>())
+        .def("distances", &astar::HeatGeodesics::distances,
+             "sources"_a, nb::call_guard<nb::gil_scoped_release>(),
+             "Distance de chaque sommet à la source la plus proche (inf si inatteignable)")
+        .def("batch_distances", &astar::HeatGeodesics::batch_distances,
+             "source_sets"_a, nb::call_guard<nb::gil_scoped_release>(),
+             "Un champ de distances par ensemble de sources, calculés en parallèle")
+        .def("trace", nb::overload_cast<const std::vector<float>&, const std::size_t>(&astar::HeatGeodesics::trace, nb::const_),
+             "distances"_a, "start"_a, nb::call_guard<nb::gil_scoped_release>(),
+             "Descente de gradient depuis un sommet jusqu'à une source")
+        .def("trace", nb::overload_cast<const std::vector<float>&, const astar::Barycenter&>(&astar::HeatGeodesics::trace, nb::const_),
+             "distances"_a, "start"_a, nb::call_guard<nb::gil_scoped_release>(),
+             "Descente de gradient depuis un point d'une face jusqu'à une source");
+
+    // Requêtes de portée (Dijkstra borné) : indices et coûts par ordre croissant de coût
+    nb::class_<astar::Reach>(m, "Reach")
+        .def(nb::init<>())
+        .def_rw("nodes", &astar::Reach::nodes)
+        .def_rw("costs", &astar::Reach::costs);
+
+    m.def("find_within",
+          [](const astar::Graph& graph, const std::vector<std::size_t>& sources, const float max_cost) { return astar::find_within(graph, sources, max_cost); },
+          "graph"_a, "sources"_a, "max_cost"_a, nb::call_guard<nb::gil_scoped_release>(),
+          "Nœuds à un coût <= max_cost de la source la plus proche");
+
+    m.def("find_nearest",
+          [](const astar::Graph& graph, const std::vector<std::size_t>& sources, const std::vector<std::size_t>& targets, const std::size_t count, const float max_cost) {
+              return astar::find_nearest(graph, sources, targets, count, max_cost);
+          },
+          "graph"_a, "sources"_a, "targets"_a, "count"_a = 1, "max_cost"_a = astar::unbounded_cost, nb::call_guard<nb::gil_scoped_release>(),
+          "Les count cibles les plus proches");
+
+    m.def("find_nearest",
+          [](const astar::Graph& graph, const std::vector<std::size_t>& sources, const astar::NodePredicate& is_target, const std::size_t count, const float max_cost) {
+              return astar::find_nearest(graph, sources, is_target, count, max_cost);
+          },
+          "graph"_a, "sources"_a, "is_target"_a, "count"_a = 1, "max_cost"_a = astar::unbounded_cost,
+          "Variante avec un prédicat Python (le GIL reste pris)");
+
+    m.def("batch_find_within",
+          [](const astar::Graph& graph, const std::vector<std::size_t>& sources, const float max_cost, const std::size_t threads) {
+              return astar::batch_find_within(graph, sources, max_cost, threads);
+          },
+          "graph"_a, "sources"_a, "max_cost"_a, "threads"_a = 0, nb::call_guard<nb::gil_scoped_release>(),
+          "Une requête par source, en parallèle");
+
+    m.def("batch_find_nearest",
+          [](const astar::Graph& graph, const std::vector<std::size_t>& sources, const std::vector<std::size_t>& targets, const std::size_t count, const float max_cost, const std::size_t threads) {
+              return astar::batch_find_nearest(graph, sources, targets, count, max_cost, threads);
+          },
+          "graph"_a, "sources"_a, "targets"_a, "count"_a = 1, "max_cost"_a = astar::unbounded_cost, "threads"_a = 0, nb::call_guard<nb::gil_scoped_release>(),
+          "Une requête par source, en parallèle");
+
+    // Graphes remplaçables à chaud : les requêtes en cours finissent sur l'ancien instantané
+    nb::class_<astar::GraphRegistry>(m, "GraphRegistry")
+        .def(nb::init<const std::size_t>(), "threads"_a = 0)
+        .def("update", &astar::GraphRegistry::update,
+             "mesh"_a, nb::call_guard<nb::gil_scoped_release>(),
+             "Construit et publie les graphes du maillage, renvoie la nouvelle version")
+        .def("request_update", &astar::GraphRegistry::request_update,
+             "mesh"_a, "Même chose sur le thread d'arrière-plan")
+        .def("wait_idle", &astar::GraphRegistry::wait_idle, nb::call_guard<nb::gil_scoped_release>())
+        .def_prop_ro("version", &astar::GraphRegistry::version);
+
     // La fonction à exposer
     m.def("find_best_path",
-          &astar::find_best_path,
+          nb::overload_cast<const astar::Mesh&, const astar::Heuristics&, const astar::Ends&, const bool, const astar::SearchOptions&>(&astar::find_best_path),
           "mesh"_a,
           "heuristics"_a,
           "ends"_a,
           nb::arg("retrieve_vertices") = false,  // nom Python lisible
+          nb::arg("options") = astar::SearchOptions{ },
+          nb::call_guard<nb::gil_scoped_release>(),
           R"doc(
               Trouve le meilleur chemin selon les heuristiques fournies.
 
@@ -69,8 +218,40 @@ NB_MODULE(astar_py, m) {
                   heuristics (Heuristics): callables Python acceptés pour `distance(a, b) -> float`.
                   ends (tuple[int,int] | tuple[Barycenter,Barycenter]): extrémités.
                   retrieve_vertices (bool): si True, remplit `Path.vertices`.
+                  options (SearchOptions): epsilon (A* pondéré) et budget de temps (ARA*).
 
               Returns:
-                  Path
+                  Path (`Path.suboptimality` borne le rapport au coût optimal)
           )doc");
+
+    m.def("find_best_path",
+          nb::overload_cast<const astar::Mesh&, const astar::Heuristics&, const astar::ComponentLabels&, const astar::Ends&, const bool, const astar::SearchOptions&>(&astar::find_best_path),
+          "mesh"_a,
+          "heuristics"_a,
+          "components"_a,
+          "ends"_a,
+          nb::arg("retrieve_vertices") = false,
+          nb::arg("options") = astar::SearchOptions{ },
+          nb::call_guard<nb::gil_scoped_release>(),
+          "Variante qui renvoie immédiatement un chemin vide si les extrémités sont dans des îlots différents");
+
+    m.def("find_best_path",
+          nb::overload_cast<const astar::Graph&, const astar::Heuristics&, const std::pair<std::size_t, std::size_t>&, const bool, const astar::SearchOptions&>(&astar::find_best_path),
+          "graph"_a,
+          "heuristics"_a,
+          "ends"_a,
+          nb::arg("retrieve_vertices") = false,
+          nb::arg("options") = astar::SearchOptions{ },
+          nb::call_guard<nb::gil_scoped_release>(),
+          "Variante sur un graphe préparé (make_vertex_graph / make_face_graph)");
+
+    m.def("find_best_path",
+          nb::overload_cast<const astar::GraphRegistry&, const astar::Heuristics&, const astar::Ends&, const bool, const astar::SearchOptions&>(&astar::find_best_path),
+          "registry"_a,
+          "heuristics"_a,
+          "ends"_a,
+          nb::arg("retrieve_vertices") = false,
+          nb::arg("options") = astar::SearchOptions{ },
+          nb::call_guard<nb::gil_scoped_release>(),
+          "Variante sur l'instantané courant d'un GraphRegistry");
 }
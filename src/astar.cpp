@@ -1,6 +1,6 @@
 #include <algorithm>
-#include <iterator>
 #include <optional>
+#include <stdexcept>
 #include <variant>
 
 #include "astar/vertex.h"
@@ -9,100 +9,36 @@
 
 #include "astar/astar.h"
 
-namespace astar {
-
-namespace detail {
+#include "geometry.h"
+#include "search.h"
 
-struct NeighborLess {
-
-    const std::vector<Vertex>& vertices;
-    const Heuristics &heuristics;
-    const std::size_t current;
-    const std::size_t target;
+namespace astar {
 
-    bool operator()(const std::size_t one, const std::size_t other) const {
-        const auto one_cost   = heuristics.distance(vertices[current], vertices[one]  ) + heuristics.distance(vertices[one]  , vertices[target]);
-        const auto other_cost = heuristics.distance(vertices[current], vertices[other]) + heuristics.distance(vertices[other], vertices[target]);
-        return one_cost < other_cost;
-    }
+FindBestPath::FindBestPath(const Mesh& m, const Heuristics& h, const bool r, const SearchOptions& o) :
+    mesh{ m }, heuristics{ h }, components{ nullptr }, retrieve_vertices{ r }, options{ o } {
 
 };
 
-struct CopyEligibleNeighbors {
-
-    const std::vector<std::size_t>& steps;
-
-    bool operator()(const std::size_t neighbor) const {
-
-        return steps.size() > 1 ? neighbor != *(std::prev(steps.end(), 2)) : true;
+FindBestPath::FindBestPath(const Mesh& m, const Heuristics& h, const ComponentLabels& c, const bool r, const SearchOptions& o) :
+    mesh{ m }, heuristics{ h }, components{ &c }, retrieve_vertices{ r }, options{ o } {
 
+    if(c.vertices.size() != m.vertices.size() || c.faces.size() != m.faces.size()) {
+        throw std::invalid_argument{ "component labels were not built for this mesh" };
     }
 
 };
 
-bool extend_steps(std::vector<std::size_t>& steps, const Vertices& vertices, const ConnectivityMap& connectivity, const Heuristics& heuristics, const std::size_t last) {
-
-    const auto back = steps.back();
-    if(back == last) {
-        return true;
-    } else {
-        auto neighbors = std::vector<std::size_t>{ };
-        std::copy_if(
-            connectivity.at(back).begin(), connectivity.at(back).end(), std::back_inserter(neighbors), CopyEligibleNeighbors{ steps }
-        );
-        steps.emplace_back(*std::min_element(
-            neighbors.begin(), neighbors.end(), detail::NeighborLess{ vertices, heuristics, back, last })
-        );
-        extend_steps(steps, vertices, connectivity, heuristics, last);     
-        return false;
-    }
-
-}
-
-Vertex face_center(const Mesh& mesh, const std::size_t i_face) {
+Path FindBestPath::unreachable() const {
 
-    const auto& face = mesh.faces[i_face];
-    const auto& a = mesh.vertices[face[0]];
-    const auto& b = mesh.vertices[face[1]];
-    const auto& c = mesh.vertices[face[2]];
-    return { (a[0] + b[0] + c[0]) / 3.f, (a[1] + b[1] + c[1]) / 3.f, (a[2] + b[2] + c[2]) / 3.f };
+    return Path{ { }, retrieve_vertices ? std::optional<Vertices>{ Vertices{ } } : std::nullopt, 1.f };
 
 }
 
-Vertices build_centroids(const Mesh &mesh) {
-
-    auto centroids = Vertices{ };
-    centroids.reserve(mesh.faces.size());
-    for(std::size_t face=0; face < mesh.faces.size(); ++face) {
-        centroids.push_back(face_center(mesh, face));
-    }
-    return centroids;
-
-}
-
-Vertices get_vertices(const Path& path, const Vertices& vertices) {
-
-    auto retrieved = Vertices{ };
-    retrieved.reserve(path.steps.size());
-    std::for_each(path.steps.begin(), path.steps.end(), [&retrieved, &vertices](const auto step) {
-        retrieved.push_back(vertices[step]);
-    });
-    return retrieved;
-}
-
-} // namespace squaremind::detail
-
-
-FindBestPath::FindBestPath(const Mesh& m, const Heuristics& h, const bool r) :
-    mesh{ m }, heuristics{ h }, retrieve_vertices{ r } {
-
-};
-
 Path FindBestPath::operator()(const std::pair<std::size_t, std::size_t>& ends) const {
 
-    auto path = Path{ { ends.first }, std::nullopt };
-    const auto connectivity = ConnectivityMapFactory::make_vertex_to_vertex(mesh.vertices, mesh.faces);
-    detail::extend_steps(path.steps, mesh.vertices, connectivity, heuristics, ends.second);
+    if(components && components->vertices.at(ends.first) != components->vertices.at(ends.second)) return unreachable();
+    const auto connectivity = ConnectivityMapFactory::make_vertex_to_vertex(mesh.vertices, mesh.faces, detail::resource_or_default(options.resource));
+    auto path = detail::search_steps(detail::ConnectivityGraph{ mesh.vertices, connectivity }, heuristics, ends.first, ends.second, options);
     if(retrieve_vertices) path.vertices = detail::get_vertices(path, mesh.vertices);
     return path;
 
@@ -110,18 +46,24 @@ Path FindBestPath::operator()(const std::pair<std::size_t, std::size_t>& ends) c
 
 Path FindBestPath::operator()(const std::pair<Barycenter, Barycenter>& ends) const {
 
-    auto path = Path{ { ends.first.face }, std::nullopt };
+    if(components && components->faces.at(ends.first.face) != components->faces.at(ends.second.face)) return unreachable();
     const auto centroids = detail::build_centroids(mesh);
-    const auto connectivity = ConnectivityMapFactory::make_face_to_face(mesh.faces);
-    detail::extend_steps(path.steps, centroids, connectivity, heuristics, ends.second.face);
+    const auto connectivity = ConnectivityMapFactory::make_face_to_face(mesh.faces, detail::resource_or_default(options.resource));
+    auto path = detail::search_steps(detail::ConnectivityGraph{ centroids, connectivity }, heuristics, ends.first.face, ends.second.face, options);
     if(retrieve_vertices) path.vertices = detail::get_vertices(path, centroids);
     return path;
     
 }
 
-Path find_best_path(const Mesh& mesh, const Heuristics& heuristics, const Ends& ends, const bool retrieve_vertices) {
+Path find_best_path(const Mesh& mesh, const Heuristics& heuristics, const Ends& ends, const bool retrieve_vertices, const SearchOptions& options) {
+
+    return std::visit(FindBestPath{ mesh, heuristics, retrieve_vertices, options }, ends);
+
+}
+
+Path find_best_path(const Mesh& mesh, const Heuristics& heuristics, const ComponentLabels& components, const Ends& ends, const bool retrieve_vertices, const SearchOptions& options) {
 
-    return std::visit(FindBestPath{ mesh, heuristics, retrieve_vertices }, ends);
+    return std::visit(FindBestPath{ mesh, heuristics, components, retrieve_vertices, options }, ends);
 
 }
 
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <array>
+
+#include "astar/components.h"
+
+#include "parallel.h"
+#include "union_find.h"
+
+namespace astar {
+
+namespace detail {
+
+namespace {
+
+struct EdgeFace {
+
+    std::array<std::size_t, 2> edge;
+    std::size_t face;
+
+    bool operator<(const EdgeFace& other) const {
+        return edge < other.edge;
+    }
+
+};
+
+Components label(ConcurrentUnionFind& sets, const std::size_t size, const std::size_t threads) {
+
+    auto roots = Components(size);
+    parallel_for(size, threads, [&sets, &roots](const std::size_t node) { roots[node] = sets.find(node); });
+    // roots are the smallest index of their set, so they are met before any other member
+    auto labels = Components(size);
+    auto next = std::size_t{ 0 };
+    for(std::size_t node=0; node < size; ++node) {
+        labels[node] = roots[node] == node ? next++ : labels[roots[node]];
+    }
+    return labels;
+
+}
+
+} // namespace astar::detail::Anonymous
+
+} // namespace astar::detail
+
+namespace ComponentsFactory {
+
+Components make_vertex_components(const Vertices& vertices, const Faces& faces, const std::size_t threads) {
+
+    auto sets = detail::ConcurrentUnionFind{ vertices.size() };
+    detail::parallel_for(faces.size(), threads, [&sets, &faces](const std::size_t face) {
+        sets.unite(faces[face][0], faces[face][1]);
+        sets.unite(faces[face][1], faces[face][2]);
+    });
+    return detail::label(sets, vertices.size(), threads);
+
+}
+
+Components make_face_components(const Faces& faces, const std::size_t threads) {
+
+    auto edges = std::vector<detail::EdgeFace>(3 * faces.size());
+    detail::parallel_for(faces.size(), threads, [&edges, &faces](const std::size_t face) {
+        for(std::size_t corner=0; corner < 3; ++corner) {
+            const auto a = faces[face][corner];
+            const auto b = faces[face][(corner + 1) % 3];
+            edges[3 * face + corner] = detail::EdgeFace{ { std::min(a, b), std::max(a, b) }, face };
+        }
+    });
+    std::sort(edges.begin(), edges.end());
+
+    // same rule as make_face_to_face: only edges shared by exactly two faces connect them
+    auto sets = detail::ConcurrentUnionFind{ faces.size() };
+    detail::parallel_for(edges.size(), threads, [&sets, &edges](const std::size_t i) {
+        const auto opens = i == 0 || edges[i - 1].edge != edges[i].edge;
+        const auto pair = i + 1 < edges.size() && edges[i + 1].edge == edges[i].edge;
+        const auto closed = i + 2 >= edges.size() || edges[i + 2].edge != edges[i].edge;
+        if(opens && pair && closed) sets.unite(edges[i].face, edges[i + 1].face);
+    });
+    return detail::label(sets, faces.size(), threads);
+
+}
+
+ComponentLabels make(const Mesh& mesh, const std::size_t threads) {
+
+    return ComponentLabels{ make_vertex_components(mesh.vertices, mesh.faces, threads), make_face_components(mesh.faces, threads) };
+
+}
+
+} // namespace astar::ComponentsFactory
+
+} // namespace astar
@@ -1,5 +1,7 @@
+#include <algorithm>
+#include <functional>
+#include <memory_resource>
 #include <unordered_map>
-#include <unordered_set>
 
 #include "astar/connectivity_map.h"
 #include "astar/edge_map.h"
@@ -8,10 +10,10 @@ namespace astar {
 
 namespace detail {
 
-using EdgeBasedConnectivityMap = std::unordered_map<Edge, std::unordered_set<std::size_t>, EdgeHash, EdgeEqual>;
+using EdgeBasedConnectivityMap = std::pmr::unordered_map<Edge, Neighbors, EdgeHash, EdgeEqual>;
 
-EdgeBasedConnectivityMap make_edge_to_face(const Faces& faces) {
-    auto connectivity = EdgeBasedConnectivityMap{ };
+EdgeBasedConnectivityMap make_edge_to_face(const Faces& faces, std::pmr::memory_resource* resource) {
+    auto connectivity = EdgeBasedConnectivityMap{ resource };
     for(std::size_t face=0; face < faces.size(); ++face) {
         const auto edges = face_edges(faces[face]);
         connectivity[edges[0]].insert(face);
@@ -26,7 +28,7 @@ struct ConnectNodes {
 
     ConnectivityMap vertices;
 
-    void operator()(const std::pair<Edge, float>& edge) {
+    void operator()(const EdgeMap::value_type& edge) {
         vertices[edge.first.v[0]].insert(edge.first.v[1]);
         vertices[edge.first.v[1]].insert(edge.first.v[0]);
     }
@@ -37,7 +39,7 @@ struct ConnectFaces {
 
     ConnectivityMap faces;
 
-    void operator()(const std::pair<Edge, std::unordered_set<std::size_t>>& edge_face) {
+    void operator()(const EdgeBasedConnectivityMap::value_type& edge_face) {
         if (edge_face.second.size() == 2) {
             const auto first  = edge_face.second.begin();
             const auto second = std::next(first);
@@ -52,19 +54,19 @@ struct ConnectFaces {
 
 namespace ConnectivityMapFactory {
 
-ConnectivityMap make_vertex_to_vertex(const Vertices& vertices, const Faces& faces) {
+ConnectivityMap make_vertex_to_vertex(const Vertices& vertices, const Faces& faces, std::pmr::memory_resource* resource) {
 
-    const auto edges = EdgeMapFactory::make(vertices, faces);
-    auto connected = detail::ConnectNodes{ };
+    const auto edges = EdgeMapFactory::make(vertices, faces, resource);
+    auto connected = detail::ConnectNodes{ ConnectivityMap{ resource } };
     std::for_each(edges.begin(), edges.end(), std::ref(connected));
     return std::move(connected.vertices);
 
 }
 
-ConnectivityMap make_face_to_face(const Faces &faces) {
+ConnectivityMap make_face_to_face(const Faces &faces, std::pmr::memory_resource* resource) {
 
-    const auto edge_faces = detail::make_edge_to_face(faces);
-    auto connected = detail::ConnectFaces{ };
+    const auto edge_faces = detail::make_edge_to_face(faces, resource);
+    auto connected = detail::ConnectFaces{ ConnectivityMap{ resource } };
     std::for_each(edge_faces.begin(), edge_faces.end(), std::ref(connected));
     return std::move(connected.faces);
 
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "astar/norms.h"
 #include "astar/vertex.h"
 #include "astar/face.h"
@@ -61,9 +63,9 @@ std::size_t EdgeHash::operator()(const Edge& edge) const noexcept {
 
 namespace EdgeMapFactory {
 
-EdgeMap make(const Vertices& vertices, const Faces& faces) {
+EdgeMap make(const Vertices& vertices, const Faces& faces, std::pmr::memory_resource* resource) {
 
-    auto edge_map = EdgeMap{ };
+    auto edge_map = EdgeMap{ resource };
     std::for_each(faces.begin(), faces.end(), detail::InsertFaceEdges{ edge_map, vertices });
     return edge_map;
 
@@ -0,0 +1,619 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include "astar/components.h"
+
+#include "astar/geodesics.h"
+
+#include "parallel.h"
+#include "sparse_matrix.h"
+
+namespace astar {
+
+namespace detail {
+
+namespace {
+
+using Vector = std::array<double, 3>;
+
+constexpr auto no_face = std::numeric_limits<std::size_t>::max();
+constexpr auto dissection_leaf = std::size_t{ 64 };
+// Regularizes the Laplacian, singular on every island, into a definite Poisson operator.
+constexpr auto poisson_shift = 1e-8;
+
+Vector to_vector(const Vertex& vertex) {
+
+    return { vertex[0], vertex[1], vertex[2] };
+
+}
+
+Vector operator-(const Vector& one, const Vector& other) {
+
+    return { one[0] - other[0], one[1] - other[1], one[2] - other[2] };
+
+}
+
+Vector operator*(const double factor, const Vector& vector) {
+
+    return { factor * vector[0], factor * vector[1], factor * vector[2] };
+
+}
+
+double dot(const Vector& one, const Vector& other) {
+
+    return one[0] * other[0] + one[1] * other[1] + one[2] * other[2];
+
+}
+
+Vector cross(const Vector& one, const Vector& other) {
+
+    return {
+        one[1] * other[2] - one[2] * other[1],
+        one[2] * other[0] - one[0] * other[2],
+        one[0] * other[1] - one[1] * other[0]
+    };
+
+}
+
+double norm(const Vector& vector) {
+
+    return std::sqrt(dot(vector, vector));
+
+}
+
+struct EdgeCorner {
+
+    std::array<std::size_t, 2> edge;
+    std::size_t face;
+    std::size_t corner;
+
+    bool operator<(const EdgeCorner& other) const {
+        return edge < other.edge;
+    }
+
+};
+
+} // namespace astar::detail::Anonymous
+
+struct HeatSystem {
+
+    Vertices vertices;
+    Faces faces;
+    std::size_t threads;
+
+    // faces around each vertex, in compressed rows
+    std::vector<std::size_t> incident_offsets;
+    std::vector<std::size_t> incident_faces;
+    // face across the edge opposite each corner
+    std::vector<std::array<std::size_t, 3>> neighbors;
+
+    std::vector<std::array<double, 3>> cotangents;
+    std::vector<Vector> normals;
+    std::vector<double> areas;
+
+    Components components;
+    std::vector<std::size_t> component_sizes;
+
+    CholeskyFactor heat;
+    CholeskyFactor poisson;
+
+    Vector position(const std::size_t vertex) const {
+        return to_vector(vertices[vertex]);
+    }
+
+    // Gradient of the barycentric coordinate of a corner, constant over the face.
+    Vector corner_gradient(const std::size_t face, const std::size_t corner) const {
+        if(areas[face] <= 0.) return { 0., 0., 0. };
+        const auto& f = faces[face];
+        const auto edge = position(f[(corner + 2) % 3]) - position(f[(corner + 1) % 3]);
+        return (0.5 / areas[face]) * cross(normals[face], edge);
+    }
+
+    template<typename Values>
+    Vector gradient(const std::size_t face, const Values& values) const {
+        auto sum = Vector{ 0., 0., 0. };
+        for(std::size_t corner=0; corner < 3; ++corner) {
+            const auto g = corner_gradient(face, corner);
+            const auto value = static_cast<double>(values[faces[face][corner]]);
+            for(std::size_t axis=0; axis < 3; ++axis) sum[axis] += value * g[axis];
+        }
+        return sum;
+    }
+
+    template<typename Visit>
+    void for_each_incident(const std::size_t vertex, Visit&& visit) const {
+        for(auto i = incident_offsets[vertex]; i < incident_offsets[vertex + 1]; ++i) {
+            const auto face = incident_faces[i];
+            const auto& f = faces[face];
+            visit(face, static_cast<std::size_t>(std::find(f.begin(), f.end(), vertex) - f.begin()));
+        }
+    }
+
+};
+
+namespace {
+
+void build_incidence(HeatSystem& system) {
+
+    const auto size = system.vertices.size();
+    system.incident_offsets.assign(size + 1, 0u);
+    for(const auto& face : system.faces) {
+        for(const auto vertex : face) {
+            if(vertex >= size) throw std::out_of_range{ "face references a missing vertex" };
+            ++system.incident_offsets[vertex + 1];
+        }
+    }
+    std::partial_sum(system.incident_offsets.begin(), system.incident_offsets.end(), system.incident_offsets.begin());
+    system.incident_faces.resize(system.incident_offsets.back());
+    auto cursor = std::vector<std::size_t>(system.incident_offsets.begin(), std::prev(system.incident_offsets.end()));
+    for(std::size_t face=0; face < system.faces.size(); ++face) {
+        for(const auto vertex : system.faces[face]) system.incident_faces[cursor[vertex]++] = face;
+    }
+
+}
+
+void build_neighbors(HeatSystem& system) {
+
+    const auto& faces = system.faces;
+    auto edges = std::vector<EdgeCorner>(3 * faces.size());
+    parallel_for(faces.size(), system.threads, [&edges, &faces](const std::size_t face) {
+        for(std::size_t corner=0; corner < 3; ++corner) {
+            const auto a = faces[face][(corner + 1) % 3];
+            const auto b = faces[face][(corner + 2) % 3];
+            edges[3 * face + corner] = EdgeCorner{ { std::min(a, b), std::max(a, b) }, face, corner };
+        }
+    });
+    std::sort(edges.begin(), edges.end());
+    system.neighbors.assign(faces.size(), { no_face, no_face, no_face });
+    for(std::size_t i=0; i + 1 < edges.size(); ++i) {
+        const auto opens = i == 0 || edges[i - 1].edge != edges[i].edge;
+        const auto pair = edges[i + 1].edge == edges[i].edge;
+        const auto closed = i + 2 >= edges.size() || edges[i + 2].edge != edges[i].edge;
+        if(!(opens && pair && closed)) continue;
+        system.neighbors[edges[i].face][edges[i].corner] = edges[i + 1].face;
+        system.neighbors[edges[i + 1].face][edges[i + 1].corner] = edges[i].face;
+    }
+
+}
+
+void build_geometry(HeatSystem& system) {
+
+    const auto count = system.faces.size();
+    system.cotangents.resize(count);
+    system.normals.resize(count);
+    system.areas.resize(count);
+    parallel_for(count, system.threads, [&system](const std::size_t face) {
+        const auto& f = system.faces[face];
+        const auto normal = cross(system.position(f[1]) - system.position(f[0]), system.position(f[2]) - system.position(f[0]));
+        const auto twice_area = norm(normal);
+        system.areas[face] = 0.5 * twice_area;
+        system.normals[face] = twice_area > 0. ? (1. / twice_area) * normal : Vector{ 0., 0., 0. };
+        for(std::size_t corner=0; corner < 3; ++corner) {
+            const auto origin = system.position(f[corner]);
+            const auto one = system.position(f[(corner + 1) % 3]) - origin;
+            const auto other = system.position(f[(corner + 2) % 3]) - origin;
+            system.cotangents[face][corner] = twice_area > 0. ? dot(one, other) / twice_area : 0.;
+        }
+    });
+
+}
+
+// Rows of the vertex graph plus the diagonal; the values are filled by build_matrices.
+SparseMatrix build_pattern(const HeatSystem& system) {
+
+    const auto size = system.vertices.size();
+    auto rows = std::vector<std::vector<std::size_t>>(size);
+    parallel_for(size, system.threads, [&system, &rows](const std::size_t vertex) {
+        auto& row = rows[vertex];
+        row.push_back(vertex);
+        system.for_each_incident(vertex, [&system, &row](const std::size_t face, const std::size_t corner) {
+            row.push_back(system.faces[face][(corner + 1) % 3]);
+            row.push_back(system.faces[face][(corner + 2) % 3]);
+        });
+        std::sort(row.begin(), row.end());
+        row.erase(std::unique(row.begin(), row.end()), row.end());
+    });
+    auto pattern = SparseMatrix{ std::vector<std::size_t>(size + 1, 0u), { }, { } };
+    for(std::size_t vertex=0; vertex < size; ++vertex) pattern.offsets[vertex + 1] = pattern.offsets[vertex] + rows[vertex].size();
+    pattern.columns.resize(pattern.offsets.back());
+    pattern.values.assign(pattern.offsets.back(), 0.);
+    parallel_for(size, system.threads, [&pattern, &rows](const std::size_t vertex) {
+        std::copy(rows[vertex].begin(), rows[vertex].end(), std::next(pattern.columns.begin(), static_cast<std::ptrdiff_t>(pattern.offsets[vertex])));
+    });
+    return pattern;
+
+}
+
+// Orders vertices by recursive coordinate bisection, each separator after both halves it
+// splits, which keeps the fill of the Cholesky factors close to n log n on surface meshes.
+class NestedDissection {
+
+private:
+
+    const HeatSystem& system;
+    const SparseMatrix& pattern;
+    std::vector<std::size_t> owner;
+    std::size_t calls;
+
+    void dissect(std::vector<std::size_t>& nodes, std::vector<std::size_t>& order) {
+        if(nodes.size() <= dissection_leaf) {
+            order.insert(order.end(), nodes.begin(), nodes.end());
+            return;
+        }
+        auto low = system.vertices[nodes.front()];
+        auto high = low;
+        for(const auto node : nodes) {
+            for(std::size_t axis=0; axis < 3; ++axis) {
+                low[axis] = std::min(low[axis], system.vertices[node][axis]);
+                high[axis] = std::max(high[axis], system.vertices[node][axis]);
+            }
+        }
+        auto axis = std::size_t{ 0 };
+        for(std::size_t candidate=1; candidate < 3; ++candidate) {
+            if(high[candidate] - low[candidate] > high[axis] - low[axis]) axis = candidate;
+        }
+        const auto middle = std::next(nodes.begin(), static_cast<std::ptrdiff_t>(nodes.size() / 2));
+        std::nth_element(nodes.begin(), middle, nodes.end(), [this, axis](const std::size_t one, const std::size_t other) {
+            return system.vertices[one][axis] < system.vertices[other][axis];
+        });
+        const auto right = 2 * ++calls;
+        for(auto node = middle; node != nodes.end(); ++node) owner[*node] = right;
+        auto left = std::vector<std::size_t>{ };
+        auto separator = std::vector<std::size_t>{ };
+        for(auto node = nodes.begin(); node != middle; ++node) {
+            auto touches = false;
+            for(auto entry = pattern.offsets[*node]; entry < pattern.offsets[*node + 1] && !touches; ++entry) touches = owner[pattern.columns[entry]] == right;
+            (touches ? separator : left).push_back(*node);
+        }
+        auto others = std::vector<std::size_t>(middle, nodes.end());
+        nodes.clear();
+        nodes.shrink_to_fit();
+        dissect(left, order);
+        dissect(others, order);
+        order.insert(order.end(), separator.begin(), separator.end());
+    }
+
+public:
+
+    NestedDissection(const HeatSystem& s, const SparseMatrix& p) : system{ s }, pattern{ p }, owner(s.vertices.size(), 0u), calls{ 0 } {
+
+    }
+
+    std::vector<std::size_t> operator()() {
+        auto nodes = std::vector<std::size_t>(system.vertices.size());
+        std::iota(nodes.begin(), nodes.end(), std::size_t{ 0 });
+        auto order = std::vector<std::size_t>{ };
+        order.reserve(nodes.size());
+        dissect(nodes, order);
+        return order;
+    }
+
+};
+
+// Cotangent Laplacian L (positive semi-definite sign) and lumped mass matrix M, then the
+// factors of the heat operator M + t L and of the Poisson operator L + shift M. Every row
+// is assembled by a single thread and both factorizations run side by side.
+void build_factors(HeatSystem& system, const float time_scale) {
+
+    auto edge_length = 0.;
+    for(std::size_t face=0; face < system.faces.size(); ++face) {
+        const auto& f = system.faces[face];
+        for(std::size_t corner=0; corner < 3; ++corner) edge_length += norm(system.position(f[(corner + 1) % 3]) - system.position(f[corner]));
+    }
+    const auto mean_length = system.faces.empty() ? 0. : edge_length / (3. * static_cast<double>(system.faces.size()));
+    const auto time = static_cast<double>(time_scale) * mean_length * mean_length;
+
+    auto laplacian = build_pattern(system);
+    auto mass = std::vector<double>(system.vertices.size(), 0.);
+    parallel_for(system.vertices.size(), system.threads, [&system, &laplacian, &mass](const std::size_t vertex) {
+        system.for_each_incident(vertex, [&system, &laplacian, &mass, vertex](const std::size_t face, const std::size_t corner) {
+            const auto next = (corner + 1) % 3;
+            const auto previous = (corner + 2) % 3;
+            const auto& cot = system.cotangents[face];
+            const auto to_next = 0.5 * cot[previous];
+            const auto to_previous = 0.5 * cot[next];
+            laplacian.at(vertex, system.faces[face][next]) -= to_next;
+            laplacian.at(vertex, system.faces[face][previous]) -= to_previous;
+            laplacian.at(vertex, vertex) += to_next + to_previous;
+            mass[vertex] += system.areas[face] / 3.;
+        });
+    });
+    auto heat = laplacian;
+    auto poisson = laplacian;
+    parallel_for(system.vertices.size(), system.threads, [&](const std::size_t vertex) {
+        for(auto entry = laplacian.offsets[vertex]; entry < laplacian.offsets[vertex + 1]; ++entry) heat.values[entry] *= time;
+        // vertices without faces are decoupled from the rest: keep their rows invertible
+        const auto isolated = mass[vertex] <= 0.;
+        heat.at(vertex, vertex) += isolated ? 1. : mass[vertex];
+        poisson.at(vertex, vertex) += isolated ? 1. : poisson_shift * mass[vertex];
+    });
+
+    const auto order = NestedDissection{ system, laplacian }();
+    parallel_for(2, system.threads, [&](const std::size_t which) {
+        if(which == 0) system.heat = CholeskyFactor{ heat, order };
+        else system.poisson = CholeskyFactor{ poisson, order };
+    });
+
+}
+
+// Steepest descent on the piecewise linear distance field, face by face.
+class Tracer {
+
+private:
+
+    static constexpr auto degenerate = 1e-12;
+    static constexpr auto on_edge = 1e-9;
+
+    const HeatSystem& system;
+    const std::vector<float>& distances;
+    Path path;
+    std::size_t budget;
+
+    void append(const Vector& point) {
+        const auto vertex = Vertex{ static_cast<float>(point[0]), static_cast<float>(point[1]), static_cast<float>(point[2]) };
+        if(path.vertices->empty() || path.vertices->back() != vertex) path.vertices->push_back(vertex);
+    }
+
+    void enter(const std::size_t face) {
+        if(path.steps.empty() || path.steps.back() != face) path.steps.push_back(face);
+    }
+
+    Vector point(const std::size_t face, const Vector& weights) const {
+        auto sum = Vector{ 0., 0., 0. };
+        for(std::size_t corner=0; corner < 3; ++corner) {
+            const auto position = system.position(system.faces[face][corner]);
+            for(std::size_t axis=0; axis < 3; ++axis) sum[axis] += weights[corner] * position[axis];
+        }
+        return sum;
+    }
+
+    bool is_minimum(const std::size_t vertex) const {
+        auto minimum = true;
+        system.for_each_incident(vertex, [this, vertex, &minimum](const std::size_t face, const std::size_t corner) {
+            const auto& f = system.faces[face];
+            minimum = minimum && distances[f[(corner + 1) % 3]] >= distances[vertex] && distances[f[(corner + 2) % 3]] >= distances[vertex];
+        });
+        return minimum;
+    }
+
+    // Change of each barycentric coordinate along the descent direction of the face.
+    Vector descent(const std::size_t face) const {
+        const auto direction = -1. * system.gradient(face, distances);
+        auto change = Vector{ };
+        for(std::size_t corner=0; corner < 3; ++corner) change[corner] = dot(system.corner_gradient(face, corner), direction);
+        return change;
+    }
+
+    // Continues from a vertex: into the incident face the descent points into, otherwise
+    // along the edge to the lowest neighbor. Returns false once a minimum is reached.
+    bool leave_vertex(std::size_t vertex, std::size_t& face, Vector& weights) {
+        while(budget-- > 0) {
+            append(system.position(vertex));
+            if(is_minimum(vertex)) return false;
+            auto best = no_face;
+            auto best_corner = std::size_t{ 0 };
+            auto best_rate = degenerate;
+            system.for_each_incident(vertex, [&](const std::size_t candidate, const std::size_t corner) {
+                const auto change = descent(candidate);
+                const auto next = change[(corner + 1) % 3];
+                const auto previous = change[(corner + 2) % 3];
+                if(next < -degenerate || previous < -degenerate || -change[corner] <= best_rate) return;
+                best = candidate;
+                best_corner = corner;
+                best_rate = -change[corner];
+            });
+            if(best != no_face) {
+                face = best;
+                weights = { 0., 0., 0. };
+                weights[best_corner] = 1.;
+                return true;
+            }
+            auto lowest = vertex;
+            system.for_each_incident(vertex, [&](const std::size_t candidate, const std::size_t corner) {
+                for(const auto other : { system.faces[candidate][(corner + 1) % 3], system.faces[candidate][(corner + 2) % 3] }) {
+                    if(distances[other] < distances[lowest]) lowest = other;
+                }
+            });
+            if(lowest == vertex) return false;
+            vertex = lowest;
+        }
+        return false;
+    }
+
+    std::size_t lowest_corner(const std::size_t face) const {
+        const auto& f = system.faces[face];
+        const auto lowest = std::min_element(f.begin(), f.end(), [this](const std::size_t one, const std::size_t other) {
+            return distances[one] < distances[other];
+        });
+        return *lowest;
+    }
+
+    void walk(std::size_t face, Vector weights) {
+        while(budget-- > 0) {
+            enter(face);
+            append(point(face, weights));
+            const auto& f = system.faces[face];
+            const auto sink = std::find_if(f.begin(), f.end(), [this](const std::size_t vertex) { return is_minimum(vertex); });
+            if(sink != f.end()) {
+                append(system.position(*sink));
+                return;
+            }
+            const auto change = descent(face);
+            auto exit = std::size_t{ 3 };
+            auto step = std::numeric_limits<double>::infinity();
+            for(std::size_t corner=0; corner < 3; ++corner) {
+                if(change[corner] < -degenerate && weights[corner] / -change[corner] < step) {
+                    exit = corner;
+                    step = weights[corner] / -change[corner];
+                }
+            }
+            if(exit == 3) {
+                if(!leave_vertex(lowest_corner(face), face, weights)) return;
+                continue;
+            }
+            if(step <= degenerate) {
+                // descent leaves through the edge just crossed: a valley, followed down the edge
+                const auto one = f[(exit + 1) % 3];
+                const auto other = f[(exit + 2) % 3];
+                if(!leave_vertex(distances[one] < distances[other] ? one : other, face, weights)) return;
+                continue;
+            }
+            for(std::size_t corner=0; corner < 3; ++corner) weights[corner] = std::max(0., weights[corner] + step * change[corner]);
+            weights[exit] = 0.;
+            const auto total = weights[0] + weights[1] + weights[2];
+            for(auto& weight : weights) weight /= total;
+            const auto next = (exit + 1) % 3;
+            const auto previous = (exit + 2) % 3;
+            const auto neighbor = system.neighbors[face][exit];
+            if(weights[next] < on_edge || weights[previous] < on_edge || neighbor == no_face) {
+                append(point(face, weights));
+                const auto corner = weights[next] < on_edge ? previous : weights[previous] < on_edge ? next
+                                  : distances[f[next]] < distances[f[previous]] ? next : previous;
+                if(!leave_vertex(f[corner], face, weights)) return;
+                continue;
+            }
+            const auto& g = system.faces[neighbor];
+            auto crossed = Vector{ 0., 0., 0. };
+            crossed[static_cast<std::size_t>(std::find(g.begin(), g.end(), f[next]) - g.begin())] = weights[next];
+            crossed[static_cast<std::size_t>(std::find(g.begin(), g.end(), f[previous]) - g.begin())] = weights[previous];
+            face = neighbor;
+            weights = crossed;
+        }
+    }
+
+public:
+
+    Tracer(const HeatSystem& s, const std::vector<float>& d) :
+        system{ s }, distances{ d }, path{ { }, Vertices{ }, 1.f }, budget{ 8 * (s.faces.size() + s.vertices.size()) + 64 } {
+
+        if(distances.size() != system.vertices.size()) throw std::invalid_argument{ "distances do not match the mesh vertices" };
+
+    }
+
+    Path from_vertex(const std::size_t vertex) {
+        if(vertex >= system.vertices.size()) throw std::out_of_range{ "start vertex out of range" };
+        if(!std::isfinite(distances[vertex])) return path;
+        auto face = no_face;
+        auto weights = Vector{ };
+        if(leave_vertex(vertex, face, weights)) walk(face, weights);
+        return std::move(path);
+    }
+
+    Path from_barycenter(const Barycenter& start) {
+        if(start.face >= system.faces.size()) throw std::out_of_range{ "start face out of range" };
+        const auto total = static_cast<double>(start.weights[0]) + start.weights[1] + start.weights[2];
+        if(!(total > 0.)) throw std::invalid_argument{ "barycentric weights must have a positive sum" };
+        const auto weights = Vector{ start.weights[0] / total, start.weights[1] / total, start.weights[2] / total };
+        const auto& f = system.faces[start.face];
+        if(!std::isfinite(distances[f[0]] + distances[f[1]] + distances[f[2]])) return path;
+        walk(start.face, weights);
+        return std::move(path);
+    }
+
+};
+
+std::vector<float> heat_distances(const HeatSystem& s, const std::vector<std::size_t>& sources, const std::size_t threads) {
+
+    const auto size = s.vertices.size();
+    auto heat = std::vector<double>(size, 0.);
+    for(const auto source : sources) {
+        if(source >= size) throw std::out_of_range{ "source vertex out of range" };
+        heat[source] = 1.;
+    }
+    s.heat.solve(heat);
+
+    // unit field pointing away from the sources, then its integrated divergence per vertex
+    auto field = std::vector<Vector>(s.faces.size());
+    parallel_for(s.faces.size(), threads, [&s, &heat, &field](const std::size_t face) {
+        const auto gradient = s.gradient(face, heat);
+        const auto length = norm(gradient);
+        field[face] = length > 0. ? (-1. / length) * gradient : Vector{ 0., 0., 0. };
+    });
+    auto divergence = std::vector<double>(size, 0.);
+    parallel_for(size, threads, [&s, &field, &divergence](const std::size_t vertex) {
+        auto sum = 0.;
+        s.for_each_incident(vertex, [&](const std::size_t face, const std::size_t corner) {
+            const auto& f = s.faces[face];
+            const auto next = (corner + 1) % 3;
+            const auto previous = (corner + 2) % 3;
+            const auto origin = s.position(vertex);
+            sum += s.cotangents[face][previous] * dot(s.position(f[next]) - origin, field[face])
+                 + s.cotangents[face][next] * dot(s.position(f[previous]) - origin, field[face]);
+        });
+        divergence[vertex] = -0.5 * sum;
+    });
+
+    // the Poisson operator is nearly singular on every island: keep the right-hand side in
+    // the range of the Laplacian so the small shift does not bias the solution
+    auto means = std::vector<double>(s.component_sizes.size(), 0.);
+    for(std::size_t vertex=0; vertex < size; ++vertex) means[s.components[vertex]] += divergence[vertex];
+    for(std::size_t vertex=0; vertex < size; ++vertex) divergence[vertex] -= means[s.components[vertex]] / static_cast<double>(s.component_sizes[s.components[vertex]]);
+    s.poisson.solve(divergence);
+    const auto& potential = divergence;
+
+    auto offsets = std::vector<double>(s.component_sizes.size(), std::numeric_limits<double>::infinity());
+    for(const auto source : sources) offsets[s.components[source]] = std::min(offsets[s.components[source]], potential[source]);
+    auto result = std::vector<float>(size);
+    for(std::size_t vertex=0; vertex < size; ++vertex) {
+        const auto offset = offsets[s.components[vertex]];
+        result[vertex] = std::isfinite(offset) ? static_cast<float>(std::max(0., potential[vertex] - offset)) : std::numeric_limits<float>::infinity();
+    }
+    for(const auto source : sources) result[source] = 0.f;
+    return result;
+
+}
+
+} // namespace astar::detail::Anonymous
+
+} // namespace astar::detail
+
+HeatGeodesics::HeatGeodesics(const Mesh& mesh, const std::size_t threads, const float time_scale) : system{ } {
+
+    auto built = std::make_shared<detail::HeatSystem>();
+    built->vertices = mesh.vertices;
+    built->faces = mesh.faces;
+    built->threads = detail::thread_count(threads);
+    detail::build_incidence(*built);
+    detail::build_neighbors(*built);
+    detail::build_geometry(*built);
+    detail::build_factors(*built, time_scale);
+    built->components = ComponentsFactory::make_vertex_components(mesh.vertices, mesh.faces, built->threads);
+    built->component_sizes.assign(built->components.empty() ? 0u : *std::max_element(built->components.begin(), built->components.end()) + 1, 0u);
+    for(const auto component : built->components) ++built->component_sizes[component];
+    system = std::move(built);
+
+}
+
+std::vector<float> HeatGeodesics::distances(const std::vector<std::size_t>& sources) const {
+
+    return detail::heat_distances(*system, sources, system->threads);
+
+}
+
+std::vector<std::vector<float>> HeatGeodesics::batch_distances(const std::vector<std::vector<std::size_t>>& source_sets) const {
+
+    auto results = std::vector<std::vector<float>>(source_sets.size());
+    detail::parallel_for(source_sets.size(), system->threads, [this, &source_sets, &results](const std::size_t set) {
+        results[set] = detail::heat_distances(*system, source_sets[set], 1u);
+    });
+    return results;
+
+}
+
+Path HeatGeodesics::trace(const std::vector<float>& distances, const std::size_t start) const {
+
+    return detail::Tracer{ *system, distances }.from_vertex(start);
+
+}
+
+Path HeatGeodesics::trace(const std::vector<float>& distances, const Barycenter& start) const {
+
+    return detail::Tracer{ *system, distances }.from_barycenter(start);
+
+}
+
+} // namespace astar
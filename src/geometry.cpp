@@ -0,0 +1,42 @@
+#include <algorithm>
+
+#include "geometry.h"
+
+namespace astar {
+
+namespace detail {
+
+Vertex face_center(const Mesh& mesh, const std::size_t i_face) {
+
+    const auto& face = mesh.faces[i_face];
+    const auto& a = mesh.vertices[face[0]];
+    const auto& b = mesh.vertices[face[1]];
+    const auto& c = mesh.vertices[face[2]];
+    return { (a[0] + b[0] + c[0]) / 3.f, (a[1] + b[1] + c[1]) / 3.f, (a[2] + b[2] + c[2]) / 3.f };
+
+}
+
+Vertices build_centroids(const Mesh &mesh) {
+
+    auto centroids = Vertices{ };
+    centroids.reserve(mesh.faces.size());
+    for(std::size_t face=0; face < mesh.faces.size(); ++face) {
+        centroids.push_back(face_center(mesh, face));
+    }
+    return centroids;
+
+}
+
+Vertices get_vertices(const Path& path, const Vertices& vertices) {
+
+    auto retrieved = Vertices{ };
+    retrieved.reserve(path.steps.size());
+    std::for_each(path.steps.begin(), path.steps.end(), [&retrieved, &vertices](const auto step) {
+        retrieved.push_back(vertices[step]);
+    });
+    return retrieved;
+}
+
+} // namespace astar::detail
+
+} // namespace astar
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "astar/mesh.h"
+#include "astar/path.h"
+#include "astar/vertex.h"
+
+namespace astar {
+
+namespace detail {
+
+Vertex face_center(const Mesh& mesh, const std::size_t i_face);
+
+Vertices build_centroids(const Mesh& mesh);
+
+Vertices get_vertices(const Path& path, const Vertices& vertices);
+
+} // namespace astar::detail
+
+} // namespace astar
@@ -0,0 +1,110 @@
+#include <limits>
+#include <stdexcept>
+
+#include "astar/graph.h"
+
+#include "geometry.h"
+#include "search.h"
+
+namespace astar {
+
+namespace GraphFactory {
+
+Graph make_vertex_graph(const Mesh& mesh, std::pmr::memory_resource* resource) {
+
+    return Graph{ mesh.vertices, ConnectivityMapFactory::make_vertex_to_vertex(mesh.vertices, mesh.faces, resource) };
+
+}
+
+Graph make_face_graph(const Mesh& mesh, std::pmr::memory_resource* resource) {
+
+    return Graph{ detail::build_centroids(mesh), ConnectivityMapFactory::make_face_to_face(mesh.faces, resource) };
+
+}
+
+} // namespace astar::GraphFactory
+
+namespace detail {
+
+namespace {
+
+template<typename Index>
+void fill_positions(const Graph& graph, const std::vector<Index>& steps, Vertices& vertices) {
+
+    vertices.clear();
+    for(const auto step : steps) vertices.push_back(graph.positions[step]);
+
+}
+
+template<typename Index>
+void search_buffers(const Graph& graph, const Heuristics& heuristics, const std::pair<std::size_t, std::size_t>& ends, PathBuffers<Index>& path, const bool retrieve_vertices, const SearchOptions& options) {
+
+    if(graph.positions.size() > static_cast<std::size_t>(std::numeric_limits<Index>::max())) {
+        throw std::length_error{ "graph too large for the requested step index type" };
+    }
+    const auto summary = search_into(ConnectivityGraph{ graph.positions, graph.connectivity }, heuristics, ends.first, ends.second, options, path.steps, &path.scratch.get());
+    path.suboptimality = summary.suboptimality;
+    path.expansions = summary.expansions;
+    if(retrieve_vertices) fill_positions(graph, path.steps, path.vertices);
+    else path.vertices.clear();
+
+}
+
+} // namespace astar::detail::Anonymous
+
+ScratchHandle::ScratchHandle() : scratch{ nullptr, [](SearchScratch* s) { delete s; } } {
+
+}
+
+ScratchHandle::ScratchHandle(const ScratchHandle&) : ScratchHandle{ } {
+
+}
+
+ScratchHandle& ScratchHandle::operator=(const ScratchHandle&) {
+
+    return *this;
+
+}
+
+SearchScratch& ScratchHandle::get() {
+
+    if(!scratch) scratch.reset(new SearchScratch{ });
+    return *scratch;
+
+}
+
+} // namespace astar::detail
+
+Path find_best_path(const Graph& graph, const Heuristics& heuristics, const std::pair<std::size_t, std::size_t>& ends, const bool retrieve_vertices, const SearchOptions& options) {
+
+    auto path = detail::search_steps(detail::ConnectivityGraph{ graph.positions, graph.connectivity }, heuristics, ends.first, ends.second, options);
+    if(retrieve_vertices) path.vertices = detail::get_vertices(path, graph.positions);
+    return path;
+
+}
+
+void find_best_path(const Graph& graph, const Heuristics& heuristics, const std::pair<std::size_t, std::size_t>& ends, PathBuffers<std::size_t>& path, const bool retrieve_vertices, const SearchOptions& options) {
+
+    detail::search_buffers(graph, heuristics, ends, path, retrieve_vertices, options);
+
+}
+
+void find_best_path(const Graph& graph, const Heuristics& heuristics, const std::pair<std::size_t, std::size_t>& ends, PathBuffers<std::uint32_t>& path, const bool retrieve_vertices, const SearchOptions& options) {
+
+    detail::search_buffers(graph, heuristics, ends, path, retrieve_vertices, options);
+
+}
+
+void fill_vertices(const Graph& graph, const std::vector<std::size_t>& steps, Vertices& vertices) {
+
+    detail::fill_positions(graph, steps, vertices);
+
+}
+
+void fill_vertices(const Graph& graph, const std::vector<std::uint32_t>& steps, Vertices& vertices) {
+
+    detail::fill_positions(graph, steps, vertices);
+
+}
+
+} // namespace astar
@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <variant>
+
+#include "astar/graph_registry.h"
+
+namespace astar {
+
+namespace detail {
+
+namespace {
+
+std::unique_ptr<GraphSnapshot> make_snapshot(Mesh mesh, const std::size_t threads) {
+
+    for(const auto& face : mesh.faces) {
+        for(const auto vertex : face) {
+            if(vertex >= mesh.vertices.size()) throw std::out_of_range{ "face references a missing vertex" };
+        }
+    }
+    auto snapshot = std::make_unique<GraphSnapshot>();
+    snapshot->vertex_graph = GraphFactory::make_vertex_graph(mesh);
+    snapshot->face_graph = GraphFactory::make_face_graph(mesh);
+    snapshot->components = ComponentsFactory::make(mesh, threads);
+    snapshot->mesh = std::move(mesh);
+    return snapshot;
+
+}
+
+struct QuerySnapshot {
+
+    const GraphSnapshot& snapshot;
+    const Heuristics& heuristics;
+    bool retrieve_vertices;
+    const SearchOptions& options;
+
+    Path unreachable() const {
+        return Path{ { }, retrieve_vertices ? std::optional<Vertices>{ Vertices{ } } : std::nullopt, 1.f };
+    }
+
+    Path operator()(const std::pair<std::size_t, std::size_t>& ends) const {
+        const auto& labels = snapshot.components.vertices;
+        if(ends.first >= labels.size() || ends.second >= labels.size()) throw std::out_of_range{ "vertex not in the current snapshot" };
+        if(labels[ends.first] != labels[ends.second]) return unreachable();
+        return find_best_path(snapshot.vertex_graph, heuristics, ends, retrieve_vertices, options);
+    }
+
+    Path operator()(const std::pair<Barycenter, Barycenter>& ends) const {
+        const auto& labels = snapshot.components.faces;
+        if(ends.first.face >= labels.size() || ends.second.face >= labels.size()) throw std::out_of_range{ "face not in the current snapshot" };
+        if(labels[ends.first.face] != labels[ends.second.face]) return unreachable();
+        return find_best_path(snapshot.face_graph, heuristics, { ends.first.face, ends.second.face }, retrieve_vertices, options);
+    }
+
+};
+
+} // namespace astar::detail::Anonymous
+
+} // namespace astar::detail
+
+SnapshotLease::SnapshotLease(const GraphRegistry& r, const std::size_t s, const GraphSnapshot* g) : registry{ &r }, slot{ s }, snapshot{ g } {
+
+}
+
+SnapshotLease::SnapshotLease(SnapshotLease&& other) noexcept : registry{ std::exchange(other.registry, nullptr) }, slot{ other.slot }, snapshot{ other.snapshot } {
+
+}
+
+SnapshotLease::~SnapshotLease() {
+
+    if(registry) registry->release(slot);
+
+}
+
+const GraphSnapshot& SnapshotLease::operator*() const {
+
+    return *snapshot;
+
+}
+
+const GraphSnapshot* SnapshotLease::operator->() const {
+
+    return snapshot;
+
+}
+
+GraphRegistry::GraphRegistry(const std::size_t t) :
+    threads{ t }, readers{ }, epoch{ 0 }, current{ new GraphSnapshot{ 0, { }, { }, { }, { } } },
+    publish_mutex{ }, retired_mutex{ }, retired{ }, has_retired{ false },
+    queue_mutex{ }, wake{ }, idle{ }, pending{ }, failure{ }, busy{ false }, stopping{ false }, worker{ } {
+
+    worker = std::thread{ &GraphRegistry::run, this };
+
+}
+
+GraphRegistry::~GraphRegistry() {
+
+    {
+        const auto lock = std::lock_guard<std::mutex>{ queue_mutex };
+        stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+    for(const auto& snapshot : retired) delete snapshot.second;
+    delete current.load();
+
+}
+
+void GraphRegistry::run() {
+
+    auto lock = std::unique_lock<std::mutex>{ queue_mutex };
+    while(true) {
+        wake.wait(lock, [this] { return stopping || pending.has_value(); });
+        if(stopping) return;
+        auto mesh = std::move(*pending);
+        pending.reset();
+        busy = true;
+        lock.unlock();
+        try {
+            update(std::move(mesh));
+        } catch(...) {
+            const auto guard = std::lock_guard<std::mutex>{ queue_mutex };
+            if(!failure) failure = std::current_exception();
+        }
+        lock.lock();
+        busy = false;
+        if(!pending) idle.notify_all();
+    }
+
+}
+
+std::uint64_t GraphRegistry::update(Mesh mesh) {
+
+    auto snapshot = detail::make_snapshot(std::move(mesh), threads);
+    const auto publishing = std::lock_guard<std::mutex>{ publish_mutex };
+    snapshot->version = current.load()->version + 1;
+    const auto version = snapshot->version;
+    const auto* replaced = current.exchange(snapshot.release());
+    // readers that entered at this epoch or before may still hold the replaced snapshot
+    const auto retired_at = epoch.fetch_add(1);
+    auto lock = std::unique_lock<std::mutex>{ retired_mutex };
+    retired.emplace_back(retired_at, replaced);
+    has_retired.store(true);
+    reclaim(lock);
+    return version;
+
+}
+
+void GraphRegistry::request_update(Mesh mesh) {
+
+    {
+        const auto lock = std::lock_guard<std::mutex>{ queue_mutex };
+        pending = std::move(mesh);
+    }
+    wake.notify_one();
+
+}
+
+void GraphRegistry::wait_idle() {
+
+    auto lock = std::unique_lock<std::mutex>{ queue_mutex };
+    idle.wait(lock, [this] { return !pending && !busy; });
+    if(failure) std::rethrow_exception(std::exchange(failure, nullptr));
+
+}
+
+SnapshotLease GraphRegistry::acquire() const {
+
+    const auto first = std::hash<std::thread::id>{ }(std::this_thread::get_id());
+    for(std::size_t attempt=0; ; ++attempt) {
+        auto& slot = readers[(first + attempt) % reader_slots];
+        auto expected = idle_slot;
+        if(slot.epoch.load() == idle_slot && slot.epoch.compare_exchange_strong(expected, epoch.load())) {
+            return SnapshotLease{ *this, (first + attempt) % reader_slots, current.load() };
+        }
+        if(attempt % reader_slots == reader_slots - 1) std::this_thread::yield();
+    }
+
+}
+
+void GraphRegistry::release(const std::size_t slot) const {
+
+    readers[slot].epoch.store(idle_slot);
+    if(!has_retired.load()) return;
+    // readers never wait: whoever holds the lock is reclaiming already
+    auto lock = std::unique_lock<std::mutex>{ retired_mutex, std::try_to_lock };
+    if(lock.owns_lock()) reclaim(lock);
+
+}
+
+std::uint64_t GraphRegistry::oldest_reader() const {
+
+    auto oldest = idle_slot;
+    for(const auto& slot : readers) oldest = std::min(oldest, slot.epoch.load());
+    return oldest;
+
+}
+
+void GraphRegistry::reclaim(std::unique_lock<std::mutex>& lock) const {
+
+    const auto oldest = oldest_reader();
+    const auto kept = std::remove_if(retired.begin(), retired.end(), [oldest](const auto& snapshot) {
+        if(snapshot.first >= oldest) return false;
+        delete snapshot.second;
+        return true;
+    });
+    retired.erase(kept, retired.end());
+    has_retired.store(!retired.empty());
+    lock.unlock();
+
+}
+
+std::uint64_t GraphRegistry::version() const {
+
+    return current.load()->version;
+
+}
+
+std::size_t GraphRegistry::retired_snapshots() const {
+
+    const auto lock = std::lock_guard<std::mutex>{ retired_mutex };
+    const auto oldest = oldest_reader();
+    return static_cast<std::size_t>(std::count_if(retired.begin(), retired.end(), [oldest](const auto& snapshot) { return snapshot.first >= oldest; }));
+
+}
+
+Path find_best_path(const GraphRegistry& registry, const Heuristics& heuristics, const Ends& ends, const bool retrieve_vertices, const SearchOptions& options) {
+
+    const auto lease = registry.acquire();
+    return std::visit(detail::QuerySnapshot{ *lease, heuristics, retrieve_vertices, options }, ends);
+
+}
+
+} // namespace astar
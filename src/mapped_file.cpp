@@ -0,0 +1,76 @@
+#include <fstream>
+#include <stdexcept>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "mapped_file.h"
+
+namespace astar {
+
+namespace detail {
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile(const std::string& path) : begin{ nullptr }, length{ 0 }, buffer{ } {
+
+    auto file = std::ifstream{ path, std::ios::binary | std::ios::ate };
+    if(!file) throw std::runtime_error{ "cannot open " + path };
+    buffer.resize(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    begin = buffer.data();
+    length = buffer.size();
+
+}
+
+MappedFile::~MappedFile() {
+
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path) : begin{ nullptr }, length{ 0 }, buffer{ } {
+
+    const auto descriptor = ::open(path.c_str(), O_RDONLY);
+    if(descriptor < 0) throw std::runtime_error{ "cannot open " + path };
+    struct stat status;
+    if(::fstat(descriptor, &status) != 0) {
+        ::close(descriptor);
+        throw std::runtime_error{ "cannot stat " + path };
+    }
+    length = static_cast<std::size_t>(status.st_size);
+    if(length > 0) {
+        auto* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if(mapped == MAP_FAILED) {
+            ::close(descriptor);
+            throw std::runtime_error{ "cannot map " + path };
+        }
+        ::madvise(mapped, length, MADV_SEQUENTIAL);
+        begin = static_cast<const char*>(mapped);
+    }
+    ::close(descriptor);
+
+}
+
+MappedFile::~MappedFile() {
+
+    if(begin) ::munmap(const_cast<char*>(begin), length);
+
+}
+
+#endif
+
+std::string_view MappedFile::view() const {
+
+    return { begin, length };
+
+}
+
+} // namespace astar::detail
+
+} // namespace astar
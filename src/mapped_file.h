@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace astar {
+
+namespace detail {
+
+// Read-only view of a whole file. Uses mmap where available so that files larger
+// than RAM are paged in on demand instead of being copied up front.
+class MappedFile {
+
+private:
+
+    const char* begin;
+    std::size_t length;
+    std::vector<char> buffer;
+
+public:
+
+    explicit MappedFile(const std::string& path);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    std::string_view view() const;
+
+};
+
+} // namespace astar::detail
+
+} // namespace astar
@@ -0,0 +1,27 @@
+#include "astar/memory_resource.h"
+
+namespace astar {
+
+namespace MemoryResourceFactory {
+
+std::unique_ptr<std::pmr::monotonic_buffer_resource> make_arena(const std::size_t initial_size, std::pmr::memory_resource* upstream) {
+
+    return std::make_unique<std::pmr::monotonic_buffer_resource>(initial_size, upstream);
+
+}
+
+std::unique_ptr<std::pmr::unsynchronized_pool_resource> make_pool(std::pmr::memory_resource* upstream) {
+
+    return std::make_unique<std::pmr::unsynchronized_pool_resource>(upstream);
+
+}
+
+std::unique_ptr<std::pmr::synchronized_pool_resource> make_shared_pool(std::pmr::memory_resource* upstream) {
+
+    return std::make_unique<std::pmr::synchronized_pool_resource>(upstream);
+
+}
+
+} // namespace astar::MemoryResourceFactory
+
+} // namespace astar
@@ -0,0 +1,660 @@
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+#include "astar/mesh_loader.h"
+
+#include "mapped_file.h"
+#include "parallel.h"
+
+namespace astar {
+
+namespace detail {
+
+namespace {
+
+constexpr auto blanks = std::string_view{ " \t\r" };
+
+std::string_view next_line(std::string_view& text) {
+
+    const auto end = text.find('\n');
+    auto line = text.substr(0, end);
+    text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+    if(!line.empty() && line.back() == '\r') line.remove_suffix(1);
+    return line;
+
+}
+
+std::string_view next_token(std::string_view& line) {
+
+    const auto begin = line.find_first_not_of(blanks);
+    if(begin == std::string_view::npos) {
+        line = { };
+        return { };
+    }
+    line.remove_prefix(begin);
+    const auto end = std::min(line.find_first_of(blanks), line.size());
+    const auto token = line.substr(0, end);
+    line.remove_prefix(end);
+    return token;
+
+}
+
+bool is_blank(const std::string_view line) {
+
+    return line.find_first_not_of(blanks) == std::string_view::npos;
+
+}
+
+template<typename Number>
+Number parse(const std::string_view token) {
+
+    auto value = Number{ };
+    const auto first = token.data() + (!token.empty() && token.front() == '+' ? 1 : 0);
+    const auto result = std::from_chars(first, token.data() + token.size(), value);
+    if(token.empty() || result.ec != std::errc{ }) throw std::runtime_error{ "malformed number '" + std::string{ token } + "'" };
+    return value;
+
+}
+
+// Splits text into at most `parts` pieces, each ending right after a newline.
+std::vector<std::string_view> split_lines(const std::string_view text, const std::size_t parts) {
+
+    auto chunks = std::vector<std::string_view>{ };
+    auto begin = std::size_t{ 0 };
+    for(std::size_t part=1; part <= parts && begin < text.size(); ++part) {
+        auto end = part == parts ? text.size() : std::max(begin, part * text.size() / parts);
+        end = std::min(text.find('\n', end), text.size());
+        end = end < text.size() ? end + 1 : end;
+        chunks.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+    return chunks;
+
+}
+
+std::vector<std::size_t> exclusive_scan(const std::vector<std::size_t>& counts) {
+
+    auto offsets = std::vector<std::size_t>(counts.size() + 1, 0u);
+    std::partial_sum(counts.begin(), counts.end(), std::next(offsets.begin()));
+    return offsets;
+
+}
+
+void fan_triangulate(Faces& faces, const std::vector<std::size_t>& corners) {
+
+    for(std::size_t k=1; k + 1 < corners.size(); ++k) {
+        faces.push_back(Face{ { corners[0], corners[k], corners[k + 1] } });
+    }
+
+}
+
+Faces concatenate(const std::vector<Faces>& chunks) {
+
+    auto sizes = std::vector<std::size_t>{ };
+    std::transform(chunks.begin(), chunks.end(), std::back_inserter(sizes), [](const auto& chunk) { return chunk.size(); });
+    const auto offsets = exclusive_scan(sizes);
+    auto faces = Faces(offsets.back());
+    for(std::size_t chunk=0; chunk < chunks.size(); ++chunk) {
+        std::copy(chunks[chunk].begin(), chunks[chunk].end(), std::next(faces.begin(), offsets[chunk]));
+    }
+    return faces;
+
+}
+
+struct VertexHash {
+
+    std::size_t operator()(const Vertex& vertex) const noexcept {
+        auto hash = std::size_t{ 0 };
+        for(const auto coordinate : vertex) {
+            hash ^= std::hash<float>{ }(coordinate) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+
+};
+
+void weld(Mesh& mesh, const std::size_t threads) {
+
+    auto first = std::unordered_map<Vertex, std::size_t, VertexHash>{ };
+    first.reserve(mesh.vertices.size());
+    auto remap = std::vector<std::size_t>(mesh.vertices.size());
+    auto unique = std::size_t{ 0 };
+    for(std::size_t vertex=0; vertex < mesh.vertices.size(); ++vertex) {
+        const auto inserted = first.emplace(mesh.vertices[vertex], unique);
+        remap[vertex] = inserted.first->second;
+        if(inserted.second) mesh.vertices[unique++] = mesh.vertices[vertex];
+    }
+    mesh.vertices.resize(unique);
+    parallel_for(mesh.faces.size(), threads, [&mesh, &remap](const std::size_t face) {
+        for(auto& corner : mesh.faces[face]) corner = remap[corner];
+    });
+    mesh.faces.erase(std::remove_if(mesh.faces.begin(), mesh.faces.end(), [](const Face& face) {
+        return face[0] == face[1] || face[1] == face[2] || face[2] == face[0];
+    }), mesh.faces.end());
+
+}
+
+// OBJ
+
+bool is_obj_vertex(const std::string_view line) {
+
+    return line.size() > 1 && line[0] == 'v' && (line[1] == ' ' || line[1] == '\t');
+
+}
+
+bool is_obj_face(const std::string_view line) {
+
+    return line.size() > 1 && line[0] == 'f' && (line[1] == ' ' || line[1] == '\t');
+
+}
+
+std::size_t count_obj_vertices(std::string_view chunk) {
+
+    auto count = std::size_t{ 0 };
+    while(!chunk.empty()) count += is_obj_vertex(next_line(chunk)) ? 1u : 0u;
+    return count;
+
+}
+
+struct ParseObjChunk {
+
+    const std::vector<std::string_view>& chunks;
+    const std::vector<std::size_t>& offsets;
+    Vertices& vertices;
+    std::vector<Faces>& faces;
+
+    void operator()(const std::size_t chunk) const {
+        auto text = chunks[chunk];
+        auto next = offsets[chunk];
+        auto corners = std::vector<std::size_t>{ };
+        while(!text.empty()) {
+            auto line = next_line(text);
+            if(is_obj_vertex(line)) {
+                next_token(line);
+                auto& vertex = vertices[next++];
+                for(auto& coordinate : vertex) coordinate = parse<float>(next_token(line));
+            } else if(is_obj_face(line)) {
+                next_token(line);
+                corners.clear();
+                for(auto token = next_token(line); !token.empty(); token = next_token(line)) {
+                    const auto index = parse<std::int64_t>(token.substr(0, token.find('/')));
+                    const auto absolute = index > 0 ? index - 1 : static_cast<std::int64_t>(next) + index;
+                    if(index == 0 || absolute < 0 || static_cast<std::size_t>(absolute) >= vertices.size()) {
+                        throw std::runtime_error{ "face index out of range" };
+                    }
+                    corners.push_back(static_cast<std::size_t>(absolute));
+                }
+                fan_triangulate(faces[chunk], corners);
+            }
+        }
+    }
+
+};
+
+// PLY
+
+enum class PlyType { int8, uint8, int16, uint16, int32, uint32, float32, float64 };
+
+enum class PlyFormat { ascii, binary_little_endian, binary_big_endian };
+
+struct PlyProperty {
+
+    std::string name;
+    PlyType type;
+    bool list;
+    PlyType count_type;
+
+};
+
+struct PlyElement {
+
+    std::string name;
+    std::size_t count;
+    std::vector<PlyProperty> properties;
+
+};
+
+struct PlyHeader {
+
+    PlyFormat format;
+    std::vector<PlyElement> elements;
+    std::string_view body;
+
+};
+
+PlyType parse_ply_type(const std::string_view name) {
+
+    static const auto types = std::unordered_map<std::string_view, PlyType>{
+        { "char"  , PlyType::int8    }, { "int8"   , PlyType::int8    },
+        { "uchar" , PlyType::uint8   }, { "uint8"  , PlyType::uint8   },
+        { "short" , PlyType::int16   }, { "int16"  , PlyType::int16   },
+        { "ushort", PlyType::uint16  }, { "uint16" , PlyType::uint16  },
+        { "int"   , PlyType::int32   }, { "int32"  , PlyType::int32   },
+        { "uint"  , PlyType::uint32  }, { "uint32" , PlyType::uint32  },
+        { "float" , PlyType::float32 }, { "float32", PlyType::float32 },
+        { "double", PlyType::float64 }, { "float64", PlyType::float64 }
+    };
+    const auto type = types.find(name);
+    if(type == types.end()) throw std::runtime_error{ "unknown PLY type '" + std::string{ name } + "'" };
+    return type->second;
+
+}
+
+std::size_t ply_size(const PlyType type) {
+
+    switch(type) {
+        case PlyType::int8   : case PlyType::uint8  : return 1u;
+        case PlyType::int16  : case PlyType::uint16 : return 2u;
+        case PlyType::int32  : case PlyType::uint32 : case PlyType::float32: return 4u;
+        case PlyType::float64: return 8u;
+    }
+    return 0u;
+
+}
+
+PlyHeader parse_ply_header(std::string_view text) {
+
+    if(next_line(text) != "ply") throw std::runtime_error{ "missing PLY magic" };
+    auto header = PlyHeader{ PlyFormat::ascii, { }, { } };
+    while(!text.empty()) {
+        auto line = next_line(text);
+        const auto keyword = next_token(line);
+        if(keyword == "end_header") {
+            header.body = text;
+            return header;
+        } else if(keyword == "format") {
+            const auto format = next_token(line);
+            if(format == "ascii") header.format = PlyFormat::ascii;
+            else if(format == "binary_little_endian") header.format = PlyFormat::binary_little_endian;
+            else if(format == "binary_big_endian") header.format = PlyFormat::binary_big_endian;
+            else throw std::runtime_error{ "unknown PLY format '" + std::string{ format } + "'" };
+        } else if(keyword == "element") {
+            const auto name = next_token(line);
+            header.elements.push_back(PlyElement{ std::string{ name }, parse<std::size_t>(next_token(line)), { } });
+        } else if(keyword == "property") {
+            if(header.elements.empty()) throw std::runtime_error{ "PLY property outside of an element" };
+            const auto type = next_token(line);
+            if(type == "list") {
+                const auto count_type = parse_ply_type(next_token(line));
+                const auto item_type = parse_ply_type(next_token(line));
+                header.elements.back().properties.push_back(PlyProperty{ std::string{ next_token(line) }, item_type, true, count_type });
+            } else {
+                const auto item_type = parse_ply_type(type);
+                header.elements.back().properties.push_back(PlyProperty{ std::string{ next_token(line) }, item_type, false, item_type });
+            }
+        }
+    }
+    throw std::runtime_error{ "missing PLY end_header" };
+
+}
+
+std::size_t find_property(const PlyElement& element, const std::initializer_list<std::string_view> names) {
+
+    for(std::size_t property=0; property < element.properties.size(); ++property) {
+        if(std::find(names.begin(), names.end(), element.properties[property].name) != names.end()) return property;
+    }
+    throw std::runtime_error{ "PLY element '" + element.name + "' lacks property '" + std::string{ *names.begin() } + "'" };
+
+}
+
+bool host_is_little_endian() {
+
+    const auto probe = std::uint16_t{ 1 };
+    auto byte = char{ };
+    std::memcpy(&byte, &probe, 1);
+    return byte == 1;
+
+}
+
+template<typename Number>
+double read_as(const char* data, const bool swap) {
+
+    char bytes[sizeof(Number)];
+    std::memcpy(bytes, data, sizeof(Number));
+    if(swap) std::reverse(std::begin(bytes), std::end(bytes));
+    auto value = Number{ };
+    std::memcpy(&value, bytes, sizeof(Number));
+    return static_cast<double>(value);
+
+}
+
+double read_binary(const char* data, const PlyType type, const bool swap) {
+
+    switch(type) {
+        case PlyType::int8   : return read_as<std::int8_t  >(data, swap);
+        case PlyType::uint8  : return read_as<std::uint8_t >(data, swap);
+        case PlyType::int16  : return read_as<std::int16_t >(data, swap);
+        case PlyType::uint16 : return read_as<std::uint16_t>(data, swap);
+        case PlyType::int32  : return read_as<std::int32_t >(data, swap);
+        case PlyType::uint32 : return read_as<std::uint32_t>(data, swap);
+        case PlyType::float32: return read_as<float        >(data, swap);
+        case PlyType::float64: return read_as<double       >(data, swap);
+    }
+    return 0.;
+
+}
+
+template<typename Number>
+std::int64_t read_integer_as(const char* data, const bool swap) {
+
+    char bytes[sizeof(Number)];
+    std::memcpy(bytes, data, sizeof(Number));
+    if(swap) std::reverse(std::begin(bytes), std::end(bytes));
+    auto value = Number{ };
+    std::memcpy(&value, bytes, sizeof(Number));
+    return static_cast<std::int64_t>(value);
+
+}
+
+std::int64_t read_integer(const char* data, const PlyType type, const bool swap) {
+
+    switch(type) {
+        case PlyType::int8   : return read_integer_as<std::int8_t  >(data, swap);
+        case PlyType::uint8  : return read_integer_as<std::uint8_t >(data, swap);
+        case PlyType::int16  : return read_integer_as<std::int16_t >(data, swap);
+        case PlyType::uint16 : return read_integer_as<std::uint16_t>(data, swap);
+        case PlyType::int32  : return read_integer_as<std::int32_t >(data, swap);
+        case PlyType::uint32 : return read_integer_as<std::uint32_t>(data, swap);
+        case PlyType::float32:
+        case PlyType::float64: break;
+    }
+    throw std::runtime_error{ "PLY list counts must be integers" };
+
+}
+
+std::size_t to_index(const double value, const std::size_t bound) {
+
+    if(value < 0. || value >= static_cast<double>(bound)) throw std::runtime_error{ "face index out of range" };
+    return static_cast<std::size_t>(value);
+
+}
+
+class BinaryPlyReader {
+
+private:
+
+    std::string_view body;
+    std::size_t cursor;
+    bool swap;
+
+    // Throws unless count records of stride bytes remain, without overflowing the product.
+    void require(const std::size_t stride, const std::size_t count=1u) const {
+        if(count != 0u && stride > (body.size() - cursor) / count) throw std::runtime_error{ "truncated PLY body" };
+    }
+
+    double read(const PlyType type) {
+        require(ply_size(type));
+        const auto value = read_binary(body.data() + cursor, type, swap);
+        cursor += ply_size(type);
+        return value;
+    }
+
+    std::size_t read_count(const PlyType type) {
+        require(ply_size(type));
+        const auto count = read_integer(body.data() + cursor, type, swap);
+        if(count < 0) throw std::runtime_error{ "negative PLY list count" };
+        cursor += ply_size(type);
+        return static_cast<std::size_t>(count);
+    }
+
+    std::size_t fixed_stride(const PlyElement& element) const {
+        auto stride = std::size_t{ 0 };
+        for(const auto& property : element.properties) {
+            if(property.list) return 0u;
+            stride += ply_size(property.type);
+        }
+        return stride;
+    }
+
+public:
+
+    BinaryPlyReader(const std::string_view b, const bool little_endian) :
+        body{ b }, cursor{ 0 }, swap{ little_endian != host_is_little_endian() } {
+
+    }
+
+    void read_vertices(const PlyElement& element, Vertices& vertices, const std::size_t threads) {
+        const auto stride = fixed_stride(element);
+        if(stride == 0u) throw std::runtime_error{ "PLY vertices with list properties are not supported" };
+        require(stride, element.count);
+        auto offsets = std::array<std::size_t, 3>{ };
+        auto types = std::array<PlyType, 3>{ };
+        const auto axes = std::array<std::string_view, 3>{ "x", "y", "z" };
+        for(std::size_t axis=0; axis < 3; ++axis) {
+            const auto property = find_property(element, { axes[axis] });
+            types[axis] = element.properties[property].type;
+            offsets[axis] = 0u;
+            for(std::size_t previous=0; previous < property; ++previous) offsets[axis] += ply_size(element.properties[previous].type);
+        }
+        const auto* records = body.data() + cursor;
+        vertices.resize(element.count);
+        parallel_for(element.count, threads, [&, records, stride](const std::size_t vertex) {
+            for(std::size_t axis=0; axis < 3; ++axis) {
+                vertices[vertex][axis] = static_cast<float>(read_binary(records + vertex * stride + offsets[axis], types[axis], swap));
+            }
+        });
+        cursor += stride * element.count;
+    }
+
+    void read_faces(const PlyElement& element, Faces& faces, const std::size_t vertex_count) {
+        const auto indices = find_property(element, { "vertex_indices", "vertex_index" });
+        auto corners = std::vector<std::size_t>{ };
+        faces.reserve(element.count);
+        for(std::size_t face=0; face < element.count; ++face) {
+            for(std::size_t property=0; property < element.properties.size(); ++property) {
+                const auto& description = element.properties[property];
+                const auto count = description.list ? read_count(description.count_type) : 1u;
+                if(property != indices) {
+                    require(ply_size(description.type), count);
+                    cursor += count * ply_size(description.type);
+                    continue;
+                }
+                corners.clear();
+                for(std::size_t corner=0; corner < count; ++corner) corners.push_back(to_index(read(description.type), vertex_count));
+                fan_triangulate(faces, corners);
+            }
+        }
+    }
+
+    void skip(const PlyElement& element) {
+        const auto stride = fixed_stride(element);
+        if(stride > 0u) {
+            require(stride, element.count);
+            cursor += stride * element.count;
+            return;
+        }
+        for(std::size_t record=0; record < element.count; ++record) {
+            for(const auto& property : element.properties) {
+                const auto count = property.list ? read_count(property.count_type) : 1u;
+                require(ply_size(property.type), count);
+                cursor += count * ply_size(property.type);
+            }
+        }
+    }
+
+};
+
+std::size_t count_lines(std::string_view chunk) {
+
+    auto count = std::size_t{ 0 };
+    while(!chunk.empty()) count += is_blank(next_line(chunk)) ? 0u : 1u;
+    return count;
+
+}
+
+struct ParseAsciiPlyChunk {
+
+    const std::vector<std::string_view>& chunks;
+    const std::vector<std::size_t>& first_lines;
+    const std::vector<PlyElement>& elements;
+    const std::vector<std::size_t>& element_lines;
+    const std::size_t vertex_element;
+    const std::size_t face_element;
+    const std::array<std::size_t, 3> axes;
+    Vertices& vertices;
+    std::vector<Faces>& faces;
+
+    void parse_vertex(std::string_view line, const std::size_t vertex) const {
+        const auto& element = elements[vertex_element];
+        auto& target = vertices[vertex];
+        for(std::size_t property=0; property < element.properties.size(); ++property) {
+            const auto list = element.properties[property].list;
+            const auto count = list ? parse<std::size_t>(next_token(line)) : 1u;
+            for(std::size_t item=0; item < count; ++item) {
+                const auto token = next_token(line);
+                if(list) continue;
+                for(std::size_t axis=0; axis < 3; ++axis) {
+                    if(property == axes[axis]) target[axis] = parse<float>(token);
+                }
+            }
+        }
+    }
+
+    void parse_face(std::string_view line, Faces& into, std::vector<std::size_t>& corners) const {
+        const auto& element = elements[face_element];
+        for(const auto& property : element.properties) {
+            const auto count = property.list ? parse<std::size_t>(next_token(line)) : 1u;
+            const auto is_indices = property.list && (property.name == "vertex_indices" || property.name == "vertex_index");
+            corners.clear();
+            for(std::size_t item=0; item < count; ++item) {
+                const auto token = next_token(line);
+                if(is_indices) corners.push_back(to_index(parse<double>(token), vertices.size()));
+            }
+            if(is_indices) fan_triangulate(into, corners);
+        }
+    }
+
+    void operator()(const std::size_t chunk) const {
+        auto text = chunks[chunk];
+        auto number = first_lines[chunk];
+        auto element = static_cast<std::size_t>(std::distance(element_lines.begin(), std::upper_bound(element_lines.begin(), element_lines.end(), number))) - 1u;
+        auto corners = std::vector<std::size_t>{ };
+        while(!text.empty()) {
+            const auto line = next_line(text);
+            if(is_blank(line)) continue;
+            while(element + 1 < element_lines.size() && number >= element_lines[element + 1]) ++element;
+            if(element == vertex_element) parse_vertex(line, number - element_lines[element]);
+            else if(element == face_element) parse_face(line, faces[chunk], corners);
+            ++number;
+        }
+    }
+
+};
+
+std::size_t find_element(const std::vector<PlyElement>& elements, const std::string_view name) {
+
+    const auto found = std::find_if(elements.begin(), elements.end(), [name](const auto& element) { return element.name == name; });
+    if(found == elements.end()) throw std::runtime_error{ "PLY file lacks a '" + std::string{ name } + "' element" };
+    return static_cast<std::size_t>(std::distance(elements.begin(), found));
+
+}
+
+Mesh load_ascii_ply(const PlyHeader& header, const std::size_t threads) {
+
+    const auto vertex_element = find_element(header.elements, "vertex");
+    const auto face_element = find_element(header.elements, "face");
+    auto element_lines = std::vector<std::size_t>{ 0u };
+    for(const auto& element : header.elements) element_lines.push_back(element_lines.back() + element.count);
+
+    const auto chunks = split_lines(header.body, thread_count(threads));
+    auto counts = std::vector<std::size_t>(chunks.size());
+    parallel_for(chunks.size(), threads, [&chunks, &counts](const std::size_t chunk) { counts[chunk] = count_lines(chunks[chunk]); });
+    const auto first_lines = exclusive_scan(counts);
+    if(first_lines.back() < element_lines.back()) throw std::runtime_error{ "truncated PLY body" };
+
+    auto mesh = Mesh{ Vertices(header.elements[vertex_element].count), { } };
+    auto faces = std::vector<Faces>(chunks.size());
+    const auto& vertex_properties = header.elements[vertex_element];
+    const auto axes = std::array<std::size_t, 3>{
+        find_property(vertex_properties, { "x" }), find_property(vertex_properties, { "y" }), find_property(vertex_properties, { "z" })
+    };
+    parallel_for(chunks.size(), threads, ParseAsciiPlyChunk{
+        chunks, first_lines, header.elements, element_lines, vertex_element, face_element, axes, mesh.vertices, faces
+    });
+    mesh.faces = concatenate(faces);
+    return mesh;
+
+}
+
+Mesh load_binary_ply(const PlyHeader& header, const std::size_t threads) {
+
+    const auto vertex_element = find_element(header.elements, "vertex");
+    const auto face_element = find_element(header.elements, "face");
+    if(vertex_element > face_element) throw std::runtime_error{ "PLY faces must follow vertices" };
+
+    auto mesh = Mesh{ };
+    auto reader = BinaryPlyReader{ header.body, header.format == PlyFormat::binary_little_endian };
+    for(std::size_t element=0; element <= face_element; ++element) {
+        if(element == vertex_element) reader.read_vertices(header.elements[element], mesh.vertices, threads);
+        else if(element == face_element) reader.read_faces(header.elements[element], mesh.faces, mesh.vertices.size());
+        else reader.skip(header.elements[element]);
+    }
+    return mesh;
+
+}
+
+bool has_extension(const std::string& path, const std::string_view extension) {
+
+    if(path.size() < extension.size()) return false;
+    return std::equal(extension.rbegin(), extension.rend(), path.rbegin(), [](const char one, const char other) {
+        return one == std::tolower(static_cast<unsigned char>(other));
+    });
+
+}
+
+} // namespace astar::detail::Anonymous
+
+} // namespace astar::detail
+
+namespace MeshLoader {
+
+Mesh load_obj(const std::string& path, const std::size_t threads) {
+
+    const auto file = detail::MappedFile{ path };
+    const auto chunks = detail::split_lines(file.view(), detail::thread_count(threads));
+
+    auto counts = std::vector<std::size_t>(chunks.size());
+    detail::parallel_for(chunks.size(), threads, [&chunks, &counts](const std::size_t chunk) {
+        counts[chunk] = detail::count_obj_vertices(chunks[chunk]);
+    });
+    const auto offsets = detail::exclusive_scan(counts);
+
+    auto mesh = Mesh{ Vertices(offsets.back()), { } };
+    auto faces = std::vector<Faces>(chunks.size());
+    detail::parallel_for(chunks.size(), threads, detail::ParseObjChunk{ chunks, offsets, mesh.vertices, faces });
+    mesh.faces = detail::concatenate(faces);
+    detail::weld(mesh, threads);
+    return mesh;
+
+}
+
+Mesh load_ply(const std::string& path, const std::size_t threads) {
+
+    const auto file = detail::MappedFile{ path };
+    const auto header = detail::parse_ply_header(file.view());
+    auto mesh = header.format == detail::PlyFormat::ascii ? detail::load_ascii_ply(header, threads) : detail::load_binary_ply(header, threads);
+    detail::weld(mesh, threads);
+    return mesh;
+
+}
+
+Mesh load(const std::string& path, const std::size_t threads) {
+
+    if(detail::has_extension(path, ".obj")) return load_obj(path, threads);
+    if(detail::has_extension(path, ".ply")) return load_ply(path, threads);
+    throw std::runtime_error{ "unsupported mesh format: " + path };
+
+}
+
+} // namespace astar::MeshLoader
+
+} // namespace astar
@@ -0,0 +1,426 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory_resource>
+#include <vector>
+
+#include "astar/search_options.h"
+
+namespace astar {
+
+namespace detail {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto no_parent = std::numeric_limits<std::size_t>::max();
+
+inline std::pmr::memory_resource* resource_or_default(std::pmr::memory_resource* resource) {
+    return resource ? resource : std::pmr::get_default_resource();
+}
+
+struct OpenNode {
+
+    float key;
+    std::size_t node;
+
+};
+
+struct OpenNodeGreater {
+
+    bool operator()(const OpenNode& one, const OpenNode& other) const {
+        return one.key > other.key;
+    }
+
+};
+
+// Writes the parent chain ending at goal, start first, reusing the capacity of steps.
+template<typename Parents, typename Index>
+void write_chain(const Parents& parent, const std::size_t goal, std::vector<Index>& steps) {
+
+    steps.clear();
+    for(auto node = goal; node != no_parent; node = parent[node]) {
+        steps.push_back(static_cast<Index>(node));
+    }
+    std::reverse(steps.begin(), steps.end());
+
+}
+
+// Open-list policies of Search. All of them offer push(node, key), which inserts node or
+// lowers its key, top() / pop() on the smallest key, for_each(visit) over the entries and
+// clear(). Lazy policies keep superseded entries around; the search skips them as stale.
+// exact_order tells whether top() is always a smallest key.
+
+// Lazy binary heap (std::push_heap / std::pop_heap).
+class BinaryHeap {
+
+private:
+
+    std::pmr::vector<OpenNode> heap;
+
+public:
+
+    static constexpr auto exact_order = true;
+
+    BinaryHeap(const std::size_t, const SearchOptions&, std::pmr::memory_resource* resource) : heap{ resource } {
+
+    }
+
+    bool empty() const {
+        return heap.empty();
+    }
+
+    void push(const std::size_t node, const float key) {
+        heap.push_back(OpenNode{ key, node });
+        std::push_heap(heap.begin(), heap.end(), OpenNodeGreater{ });
+    }
+
+    const OpenNode& top() {
+        return heap.front();
+    }
+
+    void pop() {
+        std::pop_heap(heap.begin(), heap.end(), OpenNodeGreater{ });
+        heap.pop_back();
+    }
+
+    template<typename Visit>
+    void for_each(Visit&& visit) const {
+        for(const auto& entry : heap) visit(entry);
+    }
+
+    void clear() {
+        heap.clear();
+    }
+
+};
+
+// Indexed d-ary heap: one entry per node, keys lowered in place.
+template<std::size_t Arity>
+class DaryHeap {
+
+private:
+
+    static constexpr auto absent = std::numeric_limits<std::size_t>::max();
+
+    std::pmr::vector<OpenNode> heap;
+    std::pmr::vector<std::size_t> position;
+
+    void place(const std::size_t index, const OpenNode& entry) {
+        heap[index] = entry;
+        position[entry.node] = index;
+    }
+
+    void sift_up(std::size_t index) {
+        const auto entry = heap[index];
+        while(index > 0) {
+            const auto parent = (index - 1) / Arity;
+            if(heap[parent].key <= entry.key) break;
+            place(index, heap[parent]);
+            index = parent;
+        }
+        place(index, entry);
+    }
+
+    void sift_down(std::size_t index) {
+        const auto entry = heap[index];
+        while(true) {
+            const auto first = index * Arity + 1;
+            if(first >= heap.size()) break;
+            const auto last = std::min(first + Arity, heap.size());
+            auto smallest = first;
+            for(auto child = first + 1; child < last; ++child) {
+                if(heap[child].key < heap[smallest].key) smallest = child;
+            }
+            if(heap[smallest].key >= entry.key) break;
+            place(index, heap[smallest]);
+            index = smallest;
+        }
+        place(index, entry);
+    }
+
+public:
+
+    static constexpr auto exact_order = true;
+
+    DaryHeap(const std::size_t size, const SearchOptions&, std::pmr::memory_resource* resource) : heap{ resource }, position(size, absent, resource) {
+
+    }
+
+    bool empty() const {
+        return heap.empty();
+    }
+
+    void push(const std::size_t node, const float key) {
+        if(position[node] == absent) {
+            heap.push_back(OpenNode{ key, node });
+            sift_up(heap.size() - 1);
+            return;
+        }
+        const auto index = position[node];
+        const auto lowered = key < heap[index].key;
+        heap[index].key = key;
+        if(lowered) sift_up(index);
+        else sift_down(index);
+    }
+
+    const OpenNode& top() {
+        return heap.front();
+    }
+
+    void pop() {
+        position[heap.front().node] = absent;
+        const auto last = heap.back();
+        heap.pop_back();
+        if(heap.empty()) return;
+        place(0, last);
+        sift_down(0);
+    }
+
+    template<typename Visit>
+    void for_each(Visit&& visit) const {
+        for(const auto& entry : heap) visit(entry);
+    }
+
+    void clear() {
+        for(const auto& entry : heap) position[entry.node] = absent;
+        heap.clear();
+    }
+
+};
+
+// Pairing heap over a node-indexed pool: O(1) insert and decrease-key, two-pass pop.
+class PairingHeap {
+
+private:
+
+    static constexpr auto none = std::numeric_limits<std::size_t>::max();
+
+    struct Cell {
+
+        float key;
+        std::size_t child;
+        std::size_t sibling;
+        // parent when first of its siblings, previous sibling otherwise
+        std::size_t previous;
+        bool queued;
+
+    };
+
+    std::pmr::vector<Cell> cells;
+    std::pmr::vector<std::size_t> scratch;
+    mutable std::pmr::vector<std::size_t> pending;
+    std::size_t root;
+    OpenNode front;
+
+    std::size_t meld(const std::size_t one, const std::size_t other) {
+        if(one == none) return other;
+        if(other == none) return one;
+        const auto [parent, child] = cells[other].key < cells[one].key ? std::pair{ other, one } : std::pair{ one, other };
+        cells[child].sibling = cells[parent].child;
+        if(cells[child].sibling != none) cells[cells[child].sibling].previous = child;
+        cells[child].previous = parent;
+        cells[parent].child = child;
+        cells[parent].sibling = none;
+        cells[parent].previous = none;
+        return parent;
+    }
+
+    void cut(const std::size_t node) {
+        auto& cell = cells[node];
+        if(cells[cell.previous].child == node) cells[cell.previous].child = cell.sibling;
+        else cells[cell.previous].sibling = cell.sibling;
+        if(cell.sibling != none) cells[cell.sibling].previous = cell.previous;
+        cell.sibling = none;
+        cell.previous = none;
+    }
+
+public:
+
+    static constexpr auto exact_order = true;
+
+    PairingHeap(const std::size_t size, const SearchOptions&, std::pmr::memory_resource* resource) :
+        cells(size, Cell{ 0.f, none, none, none, false }, resource), scratch{ resource }, pending{ resource }, root{ none }, front{ } {
+
+    }
+
+    bool empty() const {
+        return root == none;
+    }
+
+    void push(const std::size_t node, const float key) {
+        auto& cell = cells[node];
+        if(!cell.queued) {
+            cell = Cell{ key, none, none, none, true };
+            root = meld(root, node);
+            return;
+        }
+        if(key >= cell.key) return;
+        cell.key = key;
+        if(node == root) return;
+        cut(node);
+        root = meld(root, node);
+    }
+
+    const OpenNode& top() {
+        front = OpenNode{ cells[root].key, root };
+        return front;
+    }
+
+    void pop() {
+        scratch.clear();
+        for(auto child = cells[root].child; child != none; child = cells[child].sibling) scratch.push_back(child);
+        cells[root].queued = false;
+        cells[root].child = none;
+        for(auto i = std::size_t{ 0 }; i + 1 < scratch.size(); i += 2) scratch[i / 2] = meld(scratch[i], scratch[i + 1]);
+        if(scratch.size() % 2 == 1) scratch[scratch.size() / 2] = scratch.back();
+        scratch.resize((scratch.size() + 1) / 2);
+        auto melded = none;
+        for(auto pair = scratch.rbegin(); pair != scratch.rend(); ++pair) melded = meld(*pair, melded);
+        root = melded;
+        if(root == none) return;
+        cells[root].sibling = none;
+        cells[root].previous = none;
+    }
+
+    template<typename Visit>
+    void for_each(Visit&& visit) const {
+        if(root == none) return;
+        pending.assign(1, root);
+        while(!pending.empty()) {
+            const auto node = pending.back();
+            pending.pop_back();
+            for(auto child = cells[node].child; child != none; child = cells[child].sibling) pending.push_back(child);
+            visit(OpenNode{ cells[node].key, node });
+        }
+    }
+
+    void clear() {
+        for_each([this](const OpenNode& entry) { cells[entry.node] = Cell{ 0.f, none, none, none, false }; });
+        root = none;
+    }
+
+};
+
+// Order-preserving key codes for RadixHeap: the bit pattern of a non-negative float.
+struct FloatBitsKeys {
+
+    explicit FloatBitsKeys(const SearchOptions&) {
+
+    }
+
+    std::uint32_t operator()(const float key) const {
+        auto code = std::uint32_t{ 0 };
+        std::memcpy(&code, &key, sizeof code);
+        return key > 0.f ? code : 0u;
+    }
+
+};
+
+// Keys rounded down to a multiple of SearchOptions::key_quantum: fewer distinct codes, so
+// fewer redistributions, at the price of an arbitrary order within a quantum.
+struct QuantizedKeys {
+
+    float scale;
+
+    explicit QuantizedKeys(const SearchOptions& options) : scale{ options.key_quantum > 0.f ? 1.f / options.key_quantum : 1.f } {
+
+    }
+
+    std::uint32_t operator()(const float key) const {
+        const auto code = key * scale;
+        return code > 0.f ? static_cast<std::uint32_t>(std::min(code, 4294967295.f)) : 0u;
+    }
+
+};
+
+// Lazy radix heap for monotone keys, as produced by consistent heuristics at epsilon = 1:
+// bucket i holds the codes whose highest bit differing from the last popped code is i - 1.
+// Keys below the last popped one, and keys sharing a code, are served in any order.
+template<typename Keys>
+class RadixHeap {
+
+private:
+
+    struct Entry {
+
+        std::uint32_t code;
+        OpenNode node;
+
+    };
+
+    Keys keys;
+    std::pmr::vector<std::pmr::vector<Entry>> buckets;
+    std::uint32_t last;
+    std::size_t count;
+
+    std::size_t bucket(const std::uint32_t code) const {
+        auto difference = code ^ last;
+        auto index = std::size_t{ 0 };
+        while(difference) {
+            difference >>= 1;
+            ++index;
+        }
+        return index;
+    }
+
+    void refill() {
+        if(!buckets[0].empty()) return;
+        auto index = std::size_t{ 1 };
+        while(buckets[index].empty()) ++index;
+        auto& source = buckets[index];
+        last = std::min_element(source.begin(), source.end(), [](const Entry& one, const Entry& other) { return one.code < other.code; })->code;
+        for(const auto& entry : source) buckets[bucket(entry.code)].push_back(entry);
+        source.clear();
+    }
+
+public:
+
+    static constexpr auto exact_order = false;
+
+    RadixHeap(const std::size_t, const SearchOptions& options, std::pmr::memory_resource* resource) : keys{ options }, buckets(33, resource), last{ 0 }, count{ 0 } {
+
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    void push(const std::size_t node, const float key) {
+        const auto code = std::max(keys(key), last);
+        buckets[bucket(code)].push_back(Entry{ code, OpenNode{ key, node } });
+        ++count;
+    }
+
+    const OpenNode& top() {
+        refill();
+        return buckets[0].back().node;
+    }
+
+    void pop() {
+        refill();
+        buckets[0].pop_back();
+        --count;
+    }
+
+    template<typename Visit>
+    void for_each(Visit&& visit) const {
+        for(const auto& entries : buckets) {
+            for(const auto& entry : entries) visit(entry.node);
+        }
+    }
+
+    void clear() {
+        for(auto& entries : buckets) entries.clear();
+        last = 0;
+        count = 0;
+    }
+
+};
+
+} // namespace astar::detail
+
+} // namespace astar
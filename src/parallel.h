@@ -0,0 +1,49 @@
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace astar {
+
+namespace detail {
+
+inline std::size_t thread_count(const std::size_t requested) {
+
+    return requested > 0 ? requested : std::max<std::size_t>(1u, std::thread::hardware_concurrency());
+
+}
+
+// Calls function(i) for every i in [0, count), each thread handling one contiguous block.
+// The first exception thrown by a worker is rethrown once all of them have joined.
+template<typename Function>
+void parallel_for(const std::size_t count, const std::size_t threads, Function&& function) {
+
+    const auto blocks = std::min(count, thread_count(threads));
+    if(blocks <= 1) {
+        for(std::size_t i=0; i < count; ++i) function(i);
+        return;
+    }
+    auto errors = std::vector<std::exception_ptr>(blocks);
+    auto run = [&](const std::size_t block) {
+        try {
+            for(auto i = block * count / blocks; i < (block + 1) * count / blocks; ++i) function(i);
+        } catch(...) {
+            errors[block] = std::current_exception();
+        }
+    };
+    auto workers = std::vector<std::thread>{ };
+    workers.reserve(blocks - 1);
+    for(std::size_t block=1; block < blocks; ++block) workers.emplace_back(run, block);
+    run(0);
+    for(auto& worker : workers) worker.join();
+    for(const auto& error : errors) {
+        if(error) std::rethrow_exception(error);
+    }
+
+}
+
+} // namespace astar::detail
+
+} // namespace astar
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+#include "astar/heuristics.h"
+#include "astar/norms.h"
+
+#include "open_list.h"
+
+namespace astar {
+
+namespace detail {
+
+// Bounded single-producer / single-consumer ring over storage owned by the caller.
+template<typename Item>
+class SpscQueue {
+
+private:
+
+    Item* slots;
+    std::size_t mask;
+    alignas(64) std::atomic<std::size_t> head;
+    alignas(64) std::atomic<std::size_t> tail;
+
+public:
+
+    SpscQueue() : slots{ nullptr }, mask{ 0 }, head{ 0 }, tail{ 0 } {
+
+    }
+
+    // capacity must be a power of two
+    void attach(Item* storage, const std::size_t capacity) {
+        slots = storage;
+        mask = capacity - 1;
+    }
+
+    bool push(const Item& item) {
+        const auto back = tail.load(std::memory_order_relaxed);
+        if(back - head.load(std::memory_order_acquire) == mask + 1) return false;
+        slots[back & mask] = item;
+        tail.store(back + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(Item& item) {
+        const auto front = head.load(std::memory_order_relaxed);
+        if(front == tail.load(std::memory_order_acquire)) return false;
+        item = slots[front & mask];
+        head.store(front + 1, std::memory_order_release);
+        return true;
+    }
+
+};
+
+struct NodeMessage {
+
+    std::size_t node;
+    std::size_t parent;
+    float g;
+
+};
+
+// Hash-distributed A* (HDA*): every node is owned by one thread, chosen by hashing its
+// index, and only its owner reads or writes its g-value, parent and open entry. Relaxed
+// successors are sent to their owner through lock-free SPSC rings.
+//
+// The search stops once every thread is idle (no open entry below the incumbent goal cost)
+// and every sent message has been received; since no open node anywhere can then improve
+// on the incumbent, the returned path is optimal (within epsilon when weighted).
+template<typename Graph>
+class ParallelSearch {
+
+private:
+
+    static constexpr auto infinity = std::numeric_limits<float>::infinity();
+    static constexpr auto min_queue_capacity = std::size_t{ 1u << 6 };
+    static constexpr auto max_queue_capacity = std::size_t{ 1u << 12 };
+    static constexpr auto expansion_batch = std::size_t{ 32 };
+
+    const Graph& graph;
+    const Heuristics& heuristics;
+    const std::size_t start;
+    const std::size_t goal;
+    const float epsilon;
+    const std::size_t threads;
+
+    std::pmr::vector<float> g;
+    std::pmr::vector<float> h;
+    std::pmr::vector<std::size_t> parent;
+    std::pmr::vector<std::uint8_t> closed;
+    // worker buffers grow on several threads at once, so they go through a synchronized pool
+    std::pmr::synchronized_pool_resource pool;
+    std::pmr::vector<NodeMessage> rings;
+    std::pmr::vector<SpscQueue<NodeMessage>> queues;
+
+    std::atomic<float> incumbent;
+    std::atomic<std::size_t> sent;
+    std::atomic<std::size_t> received;
+    std::atomic<std::size_t> idle;
+    std::atomic<std::size_t> epoch;
+    std::atomic<std::size_t> expansions;
+    std::atomic<bool> done;
+    std::exception_ptr failure;
+    std::atomic<bool> failed;
+
+    std::size_t owner(const std::size_t node) const {
+        auto mixed = static_cast<std::uint64_t>(node) * 0x9e3779b97f4a7c15ull;
+        mixed ^= mixed >> 32;
+        return static_cast<std::size_t>(mixed % threads);
+    }
+
+    SpscQueue<NodeMessage>& queue(const std::size_t from, const std::size_t to) {
+        return queues[from * threads + to];
+    }
+
+    float key(const std::size_t node) {
+        if(std::isnan(h[node])) h[node] = heuristics.distance(graph.position(node), graph.position(goal));
+        return g[node] + epsilon * h[node];
+    }
+
+    void lower_incumbent(const float cost) {
+        auto current = incumbent.load();
+        while(cost < current && !incumbent.compare_exchange_weak(current, cost)) { }
+    }
+
+    void relax(const NodeMessage& message, std::pmr::vector<OpenNode>& open) {
+        if(message.g >= g[message.node]) return;
+        g[message.node] = message.g;
+        parent[message.node] = message.parent;
+        closed[message.node] = 0u;
+        if(message.node == goal) {
+            lower_incumbent(message.g);
+            return;
+        }
+        open.push_back(OpenNode{ key(message.node), message.node });
+        std::push_heap(open.begin(), open.end(), OpenNodeGreater{ });
+    }
+
+    bool expand_one(const std::size_t self, std::pmr::vector<OpenNode>& open, std::pmr::vector<std::pmr::vector<NodeMessage>>& outboxes) {
+        while(!open.empty()) {
+            const auto top = open.front();
+            if(closed[top.node] || top.key != key(top.node)) {
+                std::pop_heap(open.begin(), open.end(), OpenNodeGreater{ });
+                open.pop_back();
+                continue;
+            }
+            if(top.key >= incumbent.load(std::memory_order_relaxed)) return false;
+            std::pop_heap(open.begin(), open.end(), OpenNodeGreater{ });
+            open.pop_back();
+            closed[top.node] = 1u;
+            const auto& from = graph.position(top.node);
+            graph.for_each_neighbor(top.node, [&](const std::size_t neighbor) {
+                const auto message = NodeMessage{ neighbor, top.node, g[top.node] + euclidian_norm(from, graph.position(neighbor)) };
+                const auto destination = owner(neighbor);
+                if(destination == self) relax(message, open);
+                else outboxes[destination].push_back(message);
+            });
+            return true;
+        }
+        return false;
+    }
+
+    bool flush(const std::size_t self, std::pmr::vector<std::pmr::vector<NodeMessage>>& outboxes) {
+        auto empty = true;
+        for(std::size_t destination=0; destination < threads; ++destination) {
+            auto& outbox = outboxes[destination];
+            if(outbox.empty()) continue;
+            sent.fetch_add(outbox.size());
+            auto delivered = std::size_t{ 0 };
+            while(delivered < outbox.size() && queue(self, destination).push(outbox[delivered])) ++delivered;
+            sent.fetch_sub(outbox.size() - delivered);
+            outbox.erase(outbox.begin(), std::next(outbox.begin(), static_cast<std::ptrdiff_t>(delivered)));
+            empty = empty && outbox.empty();
+        }
+        return empty;
+    }
+
+    bool terminated() {
+        const auto before = epoch.load();
+        return idle.load() == threads && sent.load() == received.load() && epoch.load() == before;
+    }
+
+    void work(const std::size_t self) {
+        auto open = std::pmr::vector<OpenNode>{ &pool };
+        auto outboxes = std::pmr::vector<std::pmr::vector<NodeMessage>>(threads, &pool);
+        auto is_idle = false;
+        auto expanded_here = std::size_t{ 0 };
+        if(owner(start) == self) relax(NodeMessage{ start, no_parent, 0.f }, open);
+        while(!done.load(std::memory_order_relaxed)) {
+            const auto flushed = flush(self, outboxes);
+            auto count = std::size_t{ 0 };
+            auto message = NodeMessage{ };
+            for(std::size_t from=0; from < threads; ++from) {
+                while(queue(from, self).pop(message)) {
+                    if(is_idle) {
+                        // leave the idle count first: a checker that still counted this thread
+                        // idle read its epoch before the bump below, and sees it on its re-read
+                        is_idle = false;
+                        idle.fetch_sub(1);
+                        epoch.fetch_add(1);
+                    }
+                    relax(message, open);
+                    ++count;
+                }
+            }
+            if(count > 0) received.fetch_add(count);
+            auto expanded = false;
+            for(std::size_t batch=0; batch < expansion_batch && expand_one(self, open, outboxes); ++batch) {
+                expanded = true;
+                ++expanded_here;
+            }
+            if(expanded || !flushed) continue;
+            if(!is_idle) {
+                is_idle = true;
+                idle.fetch_add(1);
+            }
+            if(terminated()) done.store(true);
+            std::this_thread::yield();
+        }
+        expansions.fetch_add(expanded_here);
+    }
+
+    void guarded_work(const std::size_t self) {
+        try {
+            work(self);
+        } catch(...) {
+            if(!failed.exchange(true)) failure = std::current_exception();
+            done.store(true);
+        }
+    }
+
+public:
+
+    ParallelSearch(const Graph& gr, const Heuristics& hs, const std::size_t first, const std::size_t last, const float e, const std::size_t t, std::pmr::memory_resource* resource) :
+        graph{ gr }, heuristics{ hs }, start{ first }, goal{ last }, epsilon{ std::max(e, 1.f) }, threads{ std::max<std::size_t>(t, 1u) },
+        g(gr.size(), infinity, resource), h(gr.size(), std::nanf(""), resource), parent(gr.size(), no_parent, resource), closed(gr.size(), 0u, resource),
+        pool{ resource }, rings{ resource }, queues(threads * threads, resource),
+        incumbent{ infinity }, sent{ 0 }, received{ 0 }, idle{ 0 }, epoch{ 0 }, expansions{ 0 }, done{ false }, failure{ }, failed{ false } {
+
+        // about one slot per node across all rings: full rings only delay a flush
+        auto capacity = min_queue_capacity;
+        while(capacity < max_queue_capacity && capacity * threads * threads < gr.size()) capacity *= 2;
+        rings.resize(capacity * threads * threads);
+        for(std::size_t i=0; i < queues.size(); ++i) queues[i].attach(rings.data() + i * capacity, capacity);
+
+    }
+
+    void run() {
+        auto workers = std::vector<std::thread>{ };
+        workers.reserve(threads - 1);
+        for(std::size_t self=1; self < threads; ++self) workers.emplace_back(&ParallelSearch::guarded_work, this, self);
+        guarded_work(0);
+        for(auto& worker : workers) worker.join();
+        if(failure) std::rethrow_exception(failure);
+    }
+
+    bool reached() const {
+        return std::isfinite(g[goal]);
+    }
+
+    std::size_t expanded() const {
+        return expansions.load();
+    }
+
+    template<typename Index>
+    void write_steps(std::vector<Index>& steps) const {
+        if(reached()) write_chain(parent, goal, steps);
+        else steps.clear();
+    }
+
+};
+
+} // namespace astar::detail
+
+} // namespace astar
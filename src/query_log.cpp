@@ -0,0 +1,173 @@
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <variant>
+
+#include "astar/query_log.h"
+
+#include "mapped_file.h"
+
+namespace astar {
+
+namespace detail {
+
+namespace {
+
+constexpr auto log_magic = std::string_view{ "ASQL" };
+constexpr auto log_version = std::uint8_t{ 1 };
+constexpr auto vertex_record = std::uint8_t{ 0 };
+constexpr auto barycenter_record = std::uint8_t{ 1 };
+
+constexpr auto fnv_offset = std::uint64_t{ 0xcbf29ce484222325ull };
+constexpr auto fnv_prime = std::uint64_t{ 0x100000001b3ull };
+
+void hash_word(std::uint64_t& hash, std::uint64_t word, const std::size_t bytes) {
+
+    for(std::size_t i=0; i < bytes; ++i, word >>= 8) {
+        hash ^= word & 0xffu;
+        hash *= fnv_prime;
+    }
+
+}
+
+std::uint32_t float_bits(const float value) {
+
+    auto bits = std::uint32_t{ 0 };
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+
+}
+
+float bits_float(const std::uint32_t bits) {
+
+    auto value = 0.f;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+
+}
+
+void put(std::string& buffer, std::uint64_t word, const std::size_t bytes) {
+
+    for(std::size_t i=0; i < bytes; ++i, word >>= 8) buffer.push_back(static_cast<char>(word & 0xffu));
+
+}
+
+std::uint32_t index32(const std::size_t index) {
+
+    if(index > std::numeric_limits<std::uint32_t>::max()) throw std::out_of_range{ "query index does not fit the log format" };
+    return static_cast<std::uint32_t>(index);
+
+}
+
+void put_barycenter(std::string& buffer, const Barycenter& barycenter) {
+
+    put(buffer, index32(barycenter.face), 4);
+    for(const auto weight : barycenter.weights) put(buffer, float_bits(weight), 4);
+
+}
+
+struct Cursor {
+
+    std::string_view data;
+    std::size_t offset;
+
+    std::uint64_t take(const std::size_t bytes) {
+        if(data.size() - offset < bytes) throw std::runtime_error{ "truncated query log" };
+        auto word = std::uint64_t{ 0 };
+        for(std::size_t i=0; i < bytes; ++i) word |= std::uint64_t{ static_cast<unsigned char>(data[offset + i]) } << (8 * i);
+        offset += bytes;
+        return word;
+    }
+
+    Barycenter take_barycenter() {
+        auto barycenter = Barycenter{ static_cast<std::size_t>(take(4)), { } };
+        for(auto& weight : barycenter.weights) weight = bits_float(static_cast<std::uint32_t>(take(4)));
+        return barycenter;
+    }
+
+};
+
+} // namespace astar::detail::Anonymous
+
+} // namespace astar::detail
+
+std::uint64_t mesh_hash(const Mesh& mesh) {
+
+    auto hash = detail::fnv_offset;
+    detail::hash_word(hash, mesh.vertices.size(), 8);
+    detail::hash_word(hash, mesh.faces.size(), 8);
+    for(const auto& vertex : mesh.vertices) {
+        for(const auto coordinate : vertex) detail::hash_word(hash, detail::float_bits(coordinate), 4);
+    }
+    for(const auto& face : mesh.faces) {
+        for(const auto index : face) detail::hash_word(hash, index, 8);
+    }
+    return hash;
+
+}
+
+QueryRecorder::QueryRecorder(const std::string& path, const Mesh& mesh) : mutex{ }, stream{ path, std::ios::binary | std::ios::trunc } {
+
+    if(!stream) throw std::runtime_error{ "cannot open query log: " + path };
+    auto header = std::string{ detail::log_magic };
+    detail::put(header, detail::log_version, 1);
+    detail::put(header, mesh_hash(mesh), 8);
+    stream.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+}
+
+void QueryRecorder::record(const Ends& ends) {
+
+    auto record = std::string{ };
+    if(const auto* vertices = std::get_if<std::pair<std::size_t, std::size_t>>(&ends)) {
+        detail::put(record, detail::vertex_record, 1);
+        detail::put(record, detail::index32(vertices->first), 4);
+        detail::put(record, detail::index32(vertices->second), 4);
+    } else {
+        const auto& barycenters = std::get<std::pair<Barycenter, Barycenter>>(ends);
+        detail::put(record, detail::barycenter_record, 1);
+        detail::put_barycenter(record, barycenters.first);
+        detail::put_barycenter(record, barycenters.second);
+    }
+    const auto lock = std::lock_guard<std::mutex>{ mutex };
+    stream.write(record.data(), static_cast<std::streamsize>(record.size()));
+
+}
+
+void QueryRecorder::flush() {
+
+    const auto lock = std::lock_guard<std::mutex>{ mutex };
+    stream.flush();
+
+}
+
+namespace QueryLogLoader {
+
+QueryLog load(const std::string& path) {
+
+    const auto file = detail::MappedFile{ path };
+    auto cursor = detail::Cursor{ file.view(), 0 };
+    if(cursor.data.substr(0, detail::log_magic.size()) != detail::log_magic) throw std::runtime_error{ "not a query log: " + path };
+    cursor.offset = detail::log_magic.size();
+    if(cursor.take(1) != detail::log_version) throw std::runtime_error{ "unsupported query log version: " + path };
+    auto log = QueryLog{ cursor.take(8), { } };
+    while(cursor.offset < cursor.data.size()) {
+        const auto kind = cursor.take(1);
+        if(kind == detail::vertex_record) {
+            const auto first = static_cast<std::size_t>(cursor.take(4));
+            log.queries.emplace_back(std::pair<std::size_t, std::size_t>{ first, static_cast<std::size_t>(cursor.take(4)) });
+        } else if(kind == detail::barycenter_record) {
+            const auto first = cursor.take_barycenter();
+            log.queries.emplace_back(std::pair<Barycenter, Barycenter>{ first, cursor.take_barycenter() });
+        } else {
+            throw std::runtime_error{ "corrupted query log: " + path };
+        }
+    }
+    return log;
+
+}
+
+} // namespace astar::QueryLogLoader
+
+} // namespace astar
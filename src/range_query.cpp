@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+
+#include "astar/norms.h"
+
+#include "astar/range_query.h"
+
+#include "open_list.h"
+#include "parallel.h"
+#include "search.h"
+
+namespace astar {
+
+namespace detail {
+
+namespace {
+
+// Multi-source Dijkstra that stops at max_cost or when told to. Costs are reset node by node
+// between runs, so a batch worker only pays for what its previous query touched. Its state is
+// drawn from resource.
+class BoundedDijkstra {
+
+private:
+
+    static constexpr auto infinity = std::numeric_limits<float>::infinity();
+
+    ConnectivityGraph graph;
+    std::pmr::vector<float> cost;
+    std::pmr::vector<std::uint8_t> settled;
+    std::pmr::vector<std::size_t> touched;
+    std::pmr::vector<OpenNode> open;
+
+    void reach(const std::size_t node, const float c) {
+        if(cost[node] == infinity) touched.push_back(node);
+        cost[node] = c;
+        open.push_back(OpenNode{ c, node });
+        std::push_heap(open.begin(), open.end(), OpenNodeGreater{ });
+    }
+
+    void reset() {
+        for(const auto node : touched) {
+            cost[node] = infinity;
+            settled[node] = 0u;
+        }
+        touched.clear();
+        open.clear();
+    }
+
+public:
+
+    BoundedDijkstra(const Graph& g, std::pmr::memory_resource* resource) :
+        graph{ g.positions, g.connectivity }, cost(g.positions.size(), infinity, resource), settled(g.positions.size(), 0u, resource), touched{ resource }, open{ resource } {
+
+        if(g.positions.size() > static_cast<std::size_t>(std::numeric_limits<std::uint32_t>::max())) {
+            throw std::length_error{ "graph too large for 32-bit node indices" };
+        }
+
+    }
+
+    // Calls settle(node, cost) in order of increasing cost until it returns false.
+    template<typename Settle>
+    void run(const std::vector<std::size_t>& sources, const float max_cost, Settle&& settle) {
+        reset();
+        for(const auto source : sources) {
+            if(source >= graph.size()) throw std::out_of_range{ "source is not a node of the graph" };
+            if(cost[source] > 0.f) reach(source, 0.f);
+        }
+        while(!open.empty()) {
+            const auto top = open.front();
+            std::pop_heap(open.begin(), open.end(), OpenNodeGreater{ });
+            open.pop_back();
+            if(settled[top.node] || top.key != cost[top.node]) continue;
+            settled[top.node] = 1u;
+            if(!settle(top.node, top.key)) return;
+            const auto& from = graph.position(top.node);
+            graph.for_each_neighbor(top.node, [&](const std::size_t neighbor) {
+                const auto c = top.key + euclidian_norm(from, graph.position(neighbor));
+                if(c <= max_cost && c < cost[neighbor]) reach(neighbor, c);
+            });
+        }
+    }
+
+};
+
+void append(Reach& reach, const std::size_t node, const float cost) {
+
+    reach.nodes.push_back(static_cast<std::uint32_t>(node));
+    reach.costs.push_back(cost);
+
+}
+
+Reach within(BoundedDijkstra& dijkstra, const std::vector<std::size_t>& sources, const float max_cost) {
+
+    auto reach = Reach{ };
+    if(!(max_cost >= 0.f)) return reach;
+    dijkstra.run(sources, max_cost, [&reach](const std::size_t node, const float cost) {
+        append(reach, node, cost);
+        return true;
+    });
+    return reach;
+
+}
+
+template<typename IsTarget>
+Reach nearest(BoundedDijkstra& dijkstra, const std::vector<std::size_t>& sources, const IsTarget& is_target, const std::size_t count, const float max_cost) {
+
+    auto reach = Reach{ };
+    if(count == 0 || !(max_cost >= 0.f)) return reach;
+    dijkstra.run(sources, max_cost, [&](const std::size_t node, const float cost) {
+        if(is_target(node)) append(reach, node, cost);
+        return reach.nodes.size() < count;
+    });
+    return reach;
+
+}
+
+std::pmr::vector<std::uint8_t> make_target_mask(const Graph& graph, const std::vector<std::size_t>& targets, std::pmr::memory_resource* resource) {
+
+    auto mask = std::pmr::vector<std::uint8_t>(graph.positions.size(), 0u, resource);
+    for(const auto target : targets) {
+        if(target >= mask.size()) throw std::out_of_range{ "target is not a node of the graph" };
+        mask[target] = 1u;
+    }
+    return mask;
+
+}
+
+// Runs query(dijkstra, source) for every source, one Dijkstra state per thread. The workers
+// allocate through a synchronized pool, so resource is never called from two threads at once.
+template<typename Query>
+std::vector<Reach> batch(const Graph& graph, const std::vector<std::size_t>& sources, const std::size_t threads, std::pmr::memory_resource* resource, Query&& query) {
+
+    auto results = std::vector<Reach>(sources.size());
+    auto pool = std::pmr::synchronized_pool_resource{ resource_or_default(resource) };
+    const auto workers = std::min(sources.size(), thread_count(threads));
+    parallel_for(workers, workers, [&](const std::size_t worker) {
+        auto dijkstra = BoundedDijkstra{ graph, &pool };
+        for(auto i = worker * sources.size() / workers; i < (worker + 1) * sources.size() / workers; ++i) {
+            results[i] = query(dijkstra, std::vector<std::size_t>{ sources[i] });
+        }
+    });
+    return results;
+
+}
+
+} // namespace astar::detail::Anonymous
+
+} // namespace astar::detail
+
+Reach find_within(const Graph& graph, const std::vector<std::size_t>& sources, const float max_cost, std::pmr::memory_resource* resource) {
+
+    auto dijkstra = detail::BoundedDijkstra{ graph, detail::resource_or_default(resource) };
+    return detail::within(dijkstra, sources, max_cost);
+
+}
+
+Reach find_nearest(const Graph& graph, const std::vector<std::size_t>& sources, const NodePredicate& is_target, const std::size_t count, const float max_cost, std::pmr::memory_resource* resource) {
+
+    auto dijkstra = detail::BoundedDijkstra{ graph, detail::resource_or_default(resource) };
+    return detail::nearest(dijkstra, sources, is_target, count, max_cost);
+
+}
+
+Reach find_nearest(const Graph& graph, const std::vector<std::size_t>& sources, const std::vector<std::size_t>& targets, const std::size_t count, const float max_cost, std::pmr::memory_resource* resource) {
+
+    const auto mask = detail::make_target_mask(graph, targets, detail::resource_or_default(resource));
+    auto dijkstra = detail::BoundedDijkstra{ graph, detail::resource_or_default(resource) };
+    return detail::nearest(dijkstra, sources, [&mask](const std::size_t node) { return mask[node] != 0u; }, count, max_cost);
+
+}
+
+std::vector<Reach> batch_find_within(const Graph& graph, const std::vector<std::size_t>& sources, const float max_cost, const std::size_t threads, std::pmr::memory_resource* resource) {
+
+    return detail::batch(graph, sources, threads, resource, [max_cost](detail::BoundedDijkstra& dijkstra, const std::vector<std::size_t>& source) {
+        return detail::within(dijkstra, source, max_cost);
+    });
+
+}
+
+std::vector<Reach> batch_find_nearest(const Graph& graph, const std::vector<std::size_t>& sources, const NodePredicate& is_target, const std::size_t count, const float max_cost, const std::size_t threads, std::pmr::memory_resource* resource) {
+
+    return detail::batch(graph, sources, threads, resource, [&is_target, count, max_cost](detail::BoundedDijkstra& dijkstra, const std::vector<std::size_t>& source) {
+        return detail::nearest(dijkstra, source, is_target, count, max_cost);
+    });
+
+}
+
+std::vector<Reach> batch_find_nearest(const Graph& graph, const std::vector<std::size_t>& sources, const std::vector<std::size_t>& targets, const std::size_t count, const float max_cost, const std::size_t threads, std::pmr::memory_resource* resource) {
+
+    const auto mask = detail::make_target_mask(graph, targets, detail::resource_or_default(resource));
+    const auto is_target = [&mask](const std::size_t node) { return mask[node] != 0u; };
+    return detail::batch(graph, sources, threads, resource, [&is_target, count, max_cost](detail::BoundedDijkstra& dijkstra, const std::vector<std::size_t>& source) {
+        return detail::nearest(dijkstra, source, is_target, count, max_cost);
+    });
+
+}
+
+} // namespace astar
@@ -0,0 +1,355 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+#include "astar/connectivity_map.h"
+#include "astar/heuristics.h"
+#include "astar/norms.h"
+#include "astar/path.h"
+#include "astar/search_options.h"
+#include "astar/vertex.h"
+
+#include "open_list.h"
+#include "parallel_search.h"
+
+namespace astar {
+
+namespace detail {
+
+// Graph over dense node indices in [0, size()), the layout every search walks.
+struct ConnectivityGraph {
+
+    const Vertices& positions;
+    const ConnectivityMap& connectivity;
+
+    std::size_t size() const {
+        return positions.size();
+    }
+
+    const Vertex& position(const std::size_t node) const {
+        return positions[node];
+    }
+
+    template<typename Visit>
+    void for_each_neighbor(const std::size_t node, Visit&& visit) const {
+        const auto neighbors = connectivity.find(node);
+        if(neighbors == connectivity.end()) return;
+        for(const auto neighbor : neighbors->second) visit(neighbor);
+    }
+
+};
+
+// Per-node search state, reusable from one query to the next: a node's entries only hold
+// when its stamp matches the current generation, so starting a query costs O(1) instead of
+// refilling O(V) arrays. OpenList is one of the policies of open_list.h.
+template<typename OpenList>
+class SearchState {
+
+private:
+
+    static constexpr auto infinity = std::numeric_limits<float>::infinity();
+
+    std::pmr::vector<std::uint32_t> stamp;
+    std::uint32_t generation;
+
+public:
+
+    std::pmr::vector<float> g;
+    std::pmr::vector<float> h;
+    std::pmr::vector<std::size_t> parent;
+    std::pmr::vector<std::uint32_t> closed;
+    std::pmr::vector<bool> inconsistent;
+    OpenList open;
+    std::pmr::vector<std::size_t> incons;
+
+    SearchState(const std::size_t size, const SearchOptions& options, std::pmr::memory_resource* resource) :
+        stamp(size, 0u, resource), generation{ 0u },
+        g(size, infinity, resource), h(size, std::nanf(""), resource), parent(size, no_parent, resource), closed(size, 0u, resource),
+        inconsistent(size, false, resource), open{ size, options, resource }, incons{ resource } {
+
+    }
+
+    std::size_t size() const {
+        return stamp.size();
+    }
+
+    void begin() {
+        open.clear();
+        incons.clear();
+        if(++generation == 0u) {
+            std::fill(stamp.begin(), stamp.end(), 0u);
+            generation = 1u;
+        }
+    }
+
+    void touch(const std::size_t node) {
+        if(stamp[node] == generation) return;
+        stamp[node] = generation;
+        g[node] = infinity;
+        h[node] = std::nanf("");
+        parent[node] = no_parent;
+        closed[node] = 0u;
+        inconsistent[node] = false;
+    }
+
+};
+
+// ARA* search: g-values, closed and inconsistent sets survive between calls to
+// improve(), so that each relax() only re-expands what the new epsilon changed.
+template<typename Graph, typename OpenList=BinaryHeap>
+class Search {
+
+private:
+
+    static constexpr auto deadline_period = std::size_t{ 64 };
+
+    const Graph& graph;
+    const Heuristics& heuristics;
+    const std::size_t goal;
+
+    SearchState<OpenList>& state;
+    std::pmr::vector<float>& g;
+    std::pmr::vector<float>& h;
+    std::pmr::vector<std::size_t>& parent;
+    std::pmr::vector<std::uint32_t>& closed;
+    std::pmr::vector<bool>& inconsistent;
+    OpenList& open;
+    std::pmr::vector<std::size_t>& incons;
+    float epsilon;
+    std::uint32_t iteration;
+    std::size_t expansions;
+
+    float estimate(const std::size_t node) {
+        if(std::isnan(h[node])) h[node] = heuristics.distance(graph.position(node), graph.position(goal));
+        return h[node];
+    }
+
+    float key(const std::size_t node) {
+        return g[node] + epsilon * estimate(node);
+    }
+
+    bool is_stale(const OpenNode& entry) {
+        return closed[entry.node] == iteration || inconsistent[entry.node] || entry.key != key(entry.node);
+    }
+
+    void push(const std::size_t node) {
+        open.push(node, key(node));
+    }
+
+    void expand(const std::size_t node) {
+        ++expansions;
+        closed[node] = iteration;
+        const auto& from = graph.position(node);
+        graph.for_each_neighbor(node, [this, node, &from](const std::size_t neighbor) {
+            state.touch(neighbor);
+            const auto cost = g[node] + euclidian_norm(from, graph.position(neighbor));
+            if(cost < g[neighbor]) {
+                g[neighbor] = cost;
+                parent[neighbor] = node;
+                if(closed[neighbor] != iteration) {
+                    push(neighbor);
+                } else if(!inconsistent[neighbor]) {
+                    inconsistent[neighbor] = true;
+                    incons.push_back(neighbor);
+                }
+            }
+        });
+    }
+
+public:
+
+    Search(const Graph& gr, const Heuristics& hs, const std::size_t start, const std::size_t t, const SearchOptions& options, SearchState<OpenList>& s) :
+        graph{ gr }, heuristics{ hs }, goal{ t }, state{ s }, g{ s.g }, h{ s.h }, parent{ s.parent }, closed{ s.closed }, inconsistent{ s.inconsistent },
+        open{ s.open }, incons{ s.incons }, epsilon{ std::max(options.epsilon, 1.f) }, iteration{ 1u }, expansions{ 0 } {
+
+        state.begin();
+        state.touch(goal);
+        state.touch(start);
+        g[start] = 0.f;
+        push(start);
+
+    }
+
+    // Expands until the goal can no longer be improved at the current epsilon.
+    // Returns false when the deadline interrupted the iteration.
+    bool improve(const std::optional<Clock::time_point>& deadline) {
+        auto since_check = std::size_t{ 0 };
+        while(!open.empty()) {
+            const auto top = open.top();
+            if(is_stale(top)) {
+                open.pop();
+                continue;
+            }
+            if(top.key >= g[goal]) break;
+            if(deadline && ++since_check % deadline_period == 0 && Clock::now() >= *deadline) return false;
+            open.pop();
+            expand(top.node);
+        }
+        return true;
+    }
+
+    void relax(const float e) {
+        auto frontier = std::pmr::vector<std::size_t>{ incons.get_allocator() };
+        open.for_each([this, &frontier](const OpenNode& entry) {
+            if(!is_stale(entry)) frontier.push_back(entry.node);
+        });
+        for(const auto node : incons) {
+            inconsistent[node] = false;
+            frontier.push_back(node);
+        }
+        incons.clear();
+        open.clear();
+        epsilon = std::max(e, 1.f);
+        ++iteration;
+        for(const auto node : frontier) push(node);
+    }
+
+    float bound() const {
+        auto lowest = g[goal];
+        open.for_each([this, &lowest](const OpenNode& entry) {
+            if(closed[entry.node] != iteration) lowest = std::min(lowest, g[entry.node] + h[entry.node]);
+        });
+        for(const auto node : incons) {
+            lowest = std::min(lowest, g[node] + h[node]);
+        }
+        if(!(lowest > 0.f) || !std::isfinite(g[goal])) return 1.f;
+        // out of order expansions void the epsilon guarantee, not the open-list lower bound
+        return OpenList::exact_order ? std::min(epsilon, g[goal] / lowest) : std::max(1.f, g[goal] / lowest);
+    }
+
+    float current_epsilon() const {
+        return epsilon;
+    }
+
+    bool reached() const {
+        return std::isfinite(g[goal]);
+    }
+
+    std::size_t expanded() const {
+        return expansions;
+    }
+
+    template<typename Index>
+    void write_steps(std::vector<Index>& steps) const {
+        if(reached()) write_chain(parent, goal, steps);
+        else steps.clear();
+    }
+
+};
+
+struct SearchSummary {
+
+    float suboptimality;
+    std::size_t expansions;
+
+};
+
+// Search states kept between the queries that write into one PathBuffers. A state is rebuilt
+// when the graph size, open-list policy, key quantum or memory resource changes.
+class SearchScratch {
+
+private:
+
+    std::variant<
+        std::monostate, SearchState<BinaryHeap>, SearchState<DaryHeap<4>>, SearchState<PairingHeap>,
+        SearchState<RadixHeap<FloatBitsKeys>>, SearchState<RadixHeap<QuantizedKeys>>
+    > state;
+    float key_quantum;
+    std::pmr::memory_resource* resource;
+
+public:
+
+    SearchScratch() : state{ }, key_quantum{ 0.f }, resource{ nullptr } {
+
+    }
+
+    template<typename OpenList>
+    SearchState<OpenList>& get(const std::size_t size, const SearchOptions& options) {
+        auto* current = std::get_if<SearchState<OpenList>>(&state);
+        const auto r = resource_or_default(options.resource);
+        if(current && current->size() == size && key_quantum == options.key_quantum && resource == r) return *current;
+        state = std::monostate{ };
+        key_quantum = options.key_quantum;
+        resource = r;
+        return state.template emplace<SearchState<OpenList>>(size, options, r);
+    }
+
+};
+
+template<typename OpenList, typename Graph, typename Index>
+SearchSummary sequential_search_into(const Graph& graph, const Heuristics& heuristics, const std::size_t first, const std::size_t last, const SearchOptions& options, SearchState<OpenList>& state, std::vector<Index>& steps) {
+
+    const auto deadline = options.time_budget ? std::optional<Clock::time_point>{ Clock::now() + *options.time_budget } : std::nullopt;
+    auto search = Search<Graph, OpenList>{ graph, heuristics, first, last, options, state };
+    search.improve(std::nullopt);
+    search.write_steps(steps);
+    auto bound = search.bound();
+    if(!deadline || !search.reached()) return SearchSummary{ bound, search.expanded() };
+    while(search.current_epsilon() > 1.f && options.epsilon_step > 0.f && Clock::now() < *deadline) {
+        search.relax(search.current_epsilon() - options.epsilon_step);
+        if(!search.improve(deadline)) break;
+        search.write_steps(steps);
+        bound = search.bound();
+    }
+    return SearchSummary{ bound, search.expanded() };
+
+}
+
+template<typename OpenList, typename Graph, typename Index>
+SearchSummary sequential_search_into(const Graph& graph, const Heuristics& heuristics, const std::size_t first, const std::size_t last, const SearchOptions& options, SearchScratch* scratch, std::vector<Index>& steps) {
+
+    if(scratch) return sequential_search_into(graph, heuristics, first, last, options, scratch->get<OpenList>(graph.size(), options), steps);
+    auto state = SearchState<OpenList>{ graph.size(), options, resource_or_default(options.resource) };
+    return sequential_search_into(graph, heuristics, first, last, options, state, steps);
+
+}
+
+// Runs a plain, weighted, anytime or parallel search depending on the options, writes the
+// steps (graph nodes) into the given buffer and returns the proven suboptimality bound.
+// Sequential searches reuse the state held by scratch when one is given.
+template<typename Graph, typename Index>
+SearchSummary search_into(const Graph& graph, const Heuristics& heuristics, const std::size_t first, const std::size_t last, const SearchOptions& options, std::vector<Index>& steps, SearchScratch* scratch=nullptr) {
+
+    if(first >= graph.size() || last >= graph.size()) throw std::out_of_range{ "end is not a node of the graph" };
+    if(options.threads > 1 && !options.time_budget) {
+        auto search = ParallelSearch<Graph>{ graph, heuristics, first, last, options.epsilon, options.threads, resource_or_default(options.resource) };
+        search.run();
+        search.write_steps(steps);
+        return SearchSummary{ search.reached() ? std::max(options.epsilon, 1.f) : 1.f, search.expanded() };
+    }
+    // radix heaps need monotone keys: weighted and anytime searches use the binary heap instead
+    const auto radix = options.open_list == OpenListKind::radix_heap || options.open_list == OpenListKind::quantized_radix_heap;
+    const auto monotone = options.epsilon <= 1.f && !options.time_budget;
+    switch(radix && !monotone ? OpenListKind::binary_heap : options.open_list) {
+        case OpenListKind::quaternary_heap: return sequential_search_into<DaryHeap<4>>(graph, heuristics, first, last, options, scratch, steps);
+        case OpenListKind::pairing_heap: return sequential_search_into<PairingHeap>(graph, heuristics, first, last, options, scratch, steps);
+        case OpenListKind::radix_heap: return sequential_search_into<RadixHeap<FloatBitsKeys>>(graph, heuristics, first, last, options, scratch, steps);
+        case OpenListKind::quantized_radix_heap: return sequential_search_into<RadixHeap<QuantizedKeys>>(graph, heuristics, first, last, options, scratch, steps);
+        default: return sequential_search_into<BinaryHeap>(graph, heuristics, first, last, options, scratch, steps);
+    }
+
+}
+
+template<typename Graph>
+Path search_steps(const Graph& graph, const Heuristics& heuristics, const std::size_t first, const std::size_t last, const SearchOptions& options) {
+
+    auto path = Path{ { }, std::nullopt, 1.f, 0u };
+    const auto summary = search_into(graph, heuristics, first, last, options, path.steps);
+    path.suboptimality = summary.suboptimality;
+    path.expansions = summary.expansions;
+    return path;
+
+}
+
+} // namespace astar::detail
+
+} // namespace astar
@@ -0,0 +1,35 @@
+#include <algorithm>
+
+#include "astar/search_options.h"
+
+namespace astar {
+
+namespace SearchOptionsFactory {
+
+SearchOptions make_optimal() {
+
+    return SearchOptions{ };
+
+}
+
+SearchOptions make_weighted(const float epsilon) {
+
+    return SearchOptions{ std::max(epsilon, 1.f), 0.f, std::nullopt };
+
+}
+
+SearchOptions make_anytime(const float epsilon, const std::chrono::microseconds time_budget, const float epsilon_step) {
+
+    return SearchOptions{ std::max(epsilon, 1.f), std::max(epsilon_step, 0.f), time_budget };
+
+}
+
+SearchOptions make_parallel(const std::size_t threads, const float epsilon) {
+
+    return SearchOptions{ std::max(epsilon, 1.f), 0.f, std::nullopt, std::max<std::size_t>(threads, 1u) };
+
+}
+
+} // namespace astar::SearchOptionsFactory
+
+} // namespace astar
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+
+#include "sparse_matrix.h"
+
+namespace astar {
+
+namespace detail {
+
+namespace {
+
+// Upper triangle of P A P^T, by columns.
+struct UpperColumns {
+
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> rows;
+    std::vector<double> values;
+
+};
+
+UpperColumns permute_upper(const SparseMatrix& matrix, const std::vector<std::size_t>& rank) {
+
+    const auto size = matrix.size();
+    auto upper = UpperColumns{ std::vector<std::size_t>(size + 1, 0u), { }, { } };
+    for(std::size_t row=0; row < size; ++row) {
+        for(auto entry = matrix.offsets[row]; entry < matrix.offsets[row + 1]; ++entry) {
+            if(rank[row] <= rank[matrix.columns[entry]]) ++upper.offsets[rank[matrix.columns[entry]] + 1];
+        }
+    }
+    for(std::size_t column=0; column < size; ++column) upper.offsets[column + 1] += upper.offsets[column];
+    upper.rows.resize(upper.offsets.back());
+    upper.values.resize(upper.offsets.back());
+    auto next = std::vector<std::size_t>(upper.offsets.begin(), std::prev(upper.offsets.end()));
+    for(std::size_t row=0; row < size; ++row) {
+        for(auto entry = matrix.offsets[row]; entry < matrix.offsets[row + 1]; ++entry) {
+            const auto i = rank[row];
+            const auto j = rank[matrix.columns[entry]];
+            if(i > j) continue;
+            upper.rows[next[j]] = i;
+            upper.values[next[j]++] = matrix.values[entry];
+        }
+    }
+    return upper;
+
+}
+
+std::vector<std::size_t> elimination_tree(const UpperColumns& upper, const std::size_t size) {
+
+    constexpr auto none = static_cast<std::size_t>(-1);
+    auto parent = std::vector<std::size_t>(size, none);
+    auto ancestor = std::vector<std::size_t>(size, none);
+    for(std::size_t k=0; k < size; ++k) {
+        for(auto entry = upper.offsets[k]; entry < upper.offsets[k + 1]; ++entry) {
+            for(auto i = upper.rows[entry]; i != none && i < k; ) {
+                const auto next = ancestor[i];
+                ancestor[i] = k;
+                if(next == none) parent[i] = k;
+                i = next;
+            }
+        }
+    }
+    return parent;
+
+}
+
+// Pattern of row k of L, as the columns reached from column k of the upper triangle
+// through the elimination tree; written to stack[top..size) in topological order.
+std::size_t row_pattern(const UpperColumns& upper, const std::vector<std::size_t>& parent, const std::size_t k, std::vector<std::size_t>& stack, std::vector<std::size_t>& marks) {
+
+    const auto size = stack.size();
+    auto top = size;
+    marks[k] = k;
+    for(auto entry = upper.offsets[k]; entry < upper.offsets[k + 1]; ++entry) {
+        auto i = upper.rows[entry];
+        if(i > k) continue;
+        auto length = std::size_t{ 0 };
+        for(; marks[i] != k; i = parent[i]) {
+            stack[length++] = i;
+            marks[i] = k;
+        }
+        while(length > 0) stack[--top] = stack[--length];
+    }
+    return top;
+
+}
+
+} // namespace astar::detail::Anonymous
+
+double& SparseMatrix::at(const std::size_t row, const std::size_t column) {
+
+    const auto first = std::next(columns.begin(), static_cast<std::ptrdiff_t>(offsets[row]));
+    const auto last = std::next(columns.begin(), static_cast<std::ptrdiff_t>(offsets[row + 1]));
+    const auto found = std::lower_bound(first, last, column);
+    if(found == last || *found != column) throw std::out_of_range{ "entry outside the sparsity pattern" };
+    return values[static_cast<std::size_t>(std::distance(columns.begin(), found))];
+
+}
+
+// Up-looking factorization: row k of L is solved against the rows above it, following
+// the elimination tree for its pattern.
+CholeskyFactor::CholeskyFactor(const SparseMatrix& matrix, const std::vector<std::size_t>& elimination_order) :
+    order{ elimination_order }, offsets{ }, rows{ }, values{ } {
+
+    const auto size = matrix.size();
+    if(order.size() != size) throw std::invalid_argument{ "elimination order does not match the matrix" };
+    auto rank = std::vector<std::size_t>(size);
+    for(std::size_t k=0; k < size; ++k) rank[order[k]] = k;
+    const auto upper = permute_upper(matrix, rank);
+    const auto parent = elimination_tree(upper, size);
+
+    auto stack = std::vector<std::size_t>(size);
+    auto marks = std::vector<std::size_t>(size, static_cast<std::size_t>(-1));
+    auto counts = std::vector<std::size_t>(size, 1u);
+    for(std::size_t k=0; k < size; ++k) {
+        for(auto top = row_pattern(upper, parent, k, stack, marks); top < size; ++top) ++counts[stack[top]];
+    }
+    offsets.assign(size + 1, 0u);
+    for(std::size_t column=0; column < size; ++column) offsets[column + 1] = offsets[column] + counts[column];
+    rows.resize(offsets.back());
+    values.resize(offsets.back());
+
+    auto next = std::vector<std::size_t>(offsets.begin(), std::prev(offsets.end()));
+    auto work = std::vector<double>(size, 0.);
+    std::fill(marks.begin(), marks.end(), static_cast<std::size_t>(-1));
+    for(std::size_t k=0; k < size; ++k) {
+        const auto top = row_pattern(upper, parent, k, stack, marks);
+        for(auto entry = upper.offsets[k]; entry < upper.offsets[k + 1]; ++entry) work[upper.rows[entry]] = upper.values[entry];
+        auto diagonal = work[k];
+        work[k] = 0.;
+        for(auto position = top; position < size; ++position) {
+            const auto i = stack[position];
+            const auto factor = work[i] / values[offsets[i]];
+            work[i] = 0.;
+            for(auto entry = offsets[i] + 1; entry < next[i]; ++entry) work[rows[entry]] -= values[entry] * factor;
+            diagonal -= factor * factor;
+            rows[next[i]] = k;
+            values[next[i]++] = factor;
+        }
+        if(!(diagonal > 0.)) throw std::runtime_error{ "matrix is not positive definite" };
+        rows[next[k]] = k;
+        values[next[k]++] = std::sqrt(diagonal);
+    }
+
+}
+
+void CholeskyFactor::solve(std::vector<double>& b) const {
+
+    const auto size = order.size();
+    auto x = std::vector<double>(size);
+    for(std::size_t k=0; k < size; ++k) x[k] = b[order[k]];
+    for(std::size_t column=0; column < size; ++column) {
+        x[column] /= values[offsets[column]];
+        for(auto entry = offsets[column] + 1; entry < offsets[column + 1]; ++entry) x[rows[entry]] -= values[entry] * x[column];
+    }
+    for(auto column = size; column-- > 0; ) {
+        for(auto entry = offsets[column] + 1; entry < offsets[column + 1]; ++entry) x[column] -= values[entry] * x[rows[entry]];
+        x[column] /= values[offsets[column]];
+    }
+    for(std::size_t k=0; k < size; ++k) b[order[k]] = x[k];
+
+}
+
+} // namespace astar::detail
+
+} // namespace astar
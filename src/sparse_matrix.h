@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+
+namespace astar {
+
+namespace detail {
+
+// Symmetric matrix in compressed sparse rows, both triangles stored, each row's columns sorted.
+struct SparseMatrix {
+
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> columns;
+    std::vector<double> values;
+
+    std::size_t size() const {
+        return offsets.empty() ? 0u : offsets.size() - 1;
+    }
+
+    double& at(const std::size_t row, const std::size_t column);
+
+};
+
+// Sparse Cholesky factor L L^T = P A P^T of a symmetric positive definite matrix, with P the
+// given elimination order (order[k] is the row eliminated k-th). Built once, then every solve
+// is a forward and a backward substitution; solve() is const and may run concurrently.
+class CholeskyFactor {
+
+private:
+
+    std::vector<std::size_t> order;
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> rows;
+    std::vector<double> values;
+
+public:
+
+    CholeskyFactor() = default;
+    CholeskyFactor(const SparseMatrix& matrix, const std::vector<std::size_t>& elimination_order);
+
+    // Overwrites b with the solution of A x = b.
+    void solve(std::vector<double>& b) const;
+
+};
+
+} // namespace astar::detail
+
+} // namespace astar
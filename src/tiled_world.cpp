@@ -0,0 +1,384 @@
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "astar/connectivity_map.h"
+#include "astar/edge_map.h"
+
+#include "astar/tiled_world.h"
+
+#include "geometry.h"
+#include "search.h"
+
+namespace astar {
+
+namespace detail {
+
+struct Located {
+
+    std::size_t slot;
+    std::size_t local;
+
+};
+
+struct PreparedTile {
+
+    std::size_t id;
+    Tile tile;
+    Vertices centroids;
+    ConnectivityMap vertex_connectivity;
+    ConnectivityMap face_connectivity;
+    std::unordered_map<std::size_t, std::size_t> vertex_locals;
+    std::unordered_map<std::size_t, std::size_t> face_locals;
+    std::unordered_set<std::size_t> vertex_portals;
+    std::unordered_map<std::size_t, std::vector<Edge>> face_portals;
+
+};
+
+using PortalTable = std::unordered_map<std::size_t, std::vector<Located>>;
+
+using EdgePortalTable = std::unordered_map<Edge, std::vector<Located>, EdgeHash, EdgeEqual>;
+
+struct Residents {
+
+    std::vector<std::shared_ptr<const PreparedTile>> tiles;
+    std::vector<std::size_t> vertex_offsets;
+    std::vector<std::size_t> face_offsets;
+    PortalTable vertex_portals;
+    EdgePortalTable face_portals;
+
+};
+
+namespace {
+
+void validate(const Tile& tile) {
+
+    if(tile.vertex_ids.size() != tile.mesh.vertices.size()) throw std::invalid_argument{ "tile vertex_ids do not match its vertices" };
+    if(tile.face_ids.size() != tile.mesh.faces.size()) throw std::invalid_argument{ "tile face_ids do not match its faces" };
+    for(const auto& face : tile.mesh.faces) {
+        for(const auto vertex : face) {
+            if(vertex >= tile.mesh.vertices.size()) throw std::invalid_argument{ "tile face refers to a vertex outside the tile" };
+        }
+    }
+
+}
+
+std::shared_ptr<const PreparedTile> prepare(const std::size_t id, Tile tile) {
+
+    validate(tile);
+    auto prepared = std::make_shared<PreparedTile>();
+    prepared->id = id;
+    prepared->centroids = build_centroids(tile.mesh);
+    prepared->vertex_connectivity = ConnectivityMapFactory::make_vertex_to_vertex(tile.mesh.vertices, tile.mesh.faces);
+    prepared->face_connectivity = ConnectivityMapFactory::make_face_to_face(tile.mesh.faces);
+    for(std::size_t vertex=0; vertex < tile.vertex_ids.size(); ++vertex) prepared->vertex_locals.emplace(tile.vertex_ids[vertex], vertex);
+    for(std::size_t face=0; face < tile.face_ids.size(); ++face) prepared->face_locals.emplace(tile.face_ids[face], face);
+
+    auto edge_faces = std::unordered_map<Edge, std::vector<std::size_t>, EdgeHash, EdgeEqual>{ };
+    for(std::size_t face=0; face < tile.mesh.faces.size(); ++face) {
+        for(const auto& edge : face_edges(tile.mesh.faces[face])) edge_faces[edge].push_back(face);
+    }
+    for(const auto& [edge, faces] : edge_faces) {
+        if(faces.size() != 1) continue;
+        prepared->vertex_portals.insert(edge.v[0]);
+        prepared->vertex_portals.insert(edge.v[1]);
+        prepared->face_portals[faces.front()].push_back(Edge{ { tile.vertex_ids[edge.v[0]], tile.vertex_ids[edge.v[1]] } });
+    }
+    prepared->tile = std::move(tile);
+    return prepared;
+
+}
+
+std::shared_ptr<const Residents> make_residents(std::vector<std::shared_ptr<const PreparedTile>> tiles) {
+
+    auto residents = std::make_shared<Residents>();
+    residents->vertex_offsets.push_back(0u);
+    residents->face_offsets.push_back(0u);
+    for(std::size_t slot=0; slot < tiles.size(); ++slot) {
+        const auto& tile = *tiles[slot];
+        residents->vertex_offsets.push_back(residents->vertex_offsets.back() + tile.tile.mesh.vertices.size());
+        residents->face_offsets.push_back(residents->face_offsets.back() + tile.tile.mesh.faces.size());
+        for(const auto vertex : tile.vertex_portals) {
+            residents->vertex_portals[tile.tile.vertex_ids[vertex]].push_back(Located{ slot, vertex });
+        }
+        for(const auto& [face, edges] : tile.face_portals) {
+            for(const auto& edge : edges) residents->face_portals[edge].push_back(Located{ slot, face });
+        }
+    }
+    residents->tiles = std::move(tiles);
+    return residents;
+
+}
+
+Located locate(const std::vector<std::size_t>& offsets, const std::size_t node) {
+
+    const auto slot = static_cast<std::size_t>(std::distance(offsets.begin(), std::upper_bound(offsets.begin(), offsets.end(), node))) - 1u;
+    return Located{ slot, node - offsets[slot] };
+
+}
+
+// Vertex graph of the resident tiles; copies of a shared vertex are linked by zero-length portal edges.
+struct TiledVertexGraph {
+
+    const Residents& residents;
+
+    std::size_t size() const {
+        return residents.vertex_offsets.back();
+    }
+
+    const Vertex& position(const std::size_t node) const {
+        const auto at = locate(residents.vertex_offsets, node);
+        return residents.tiles[at.slot]->tile.mesh.vertices[at.local];
+    }
+
+    template<typename Visit>
+    void for_each_neighbor(const std::size_t node, Visit&& visit) const {
+        const auto at = locate(residents.vertex_offsets, node);
+        const auto& tile = *residents.tiles[at.slot];
+        const auto offset = residents.vertex_offsets[at.slot];
+        const auto neighbors = tile.vertex_connectivity.find(at.local);
+        if(neighbors != tile.vertex_connectivity.end()) {
+            for(const auto neighbor : neighbors->second) visit(offset + neighbor);
+        }
+        if(!tile.vertex_portals.count(at.local)) return;
+        const auto copies = residents.vertex_portals.find(tile.tile.vertex_ids[at.local]);
+        for(const auto& copy : copies->second) {
+            if(copy.slot != at.slot) visit(residents.vertex_offsets[copy.slot] + copy.local);
+        }
+    }
+
+};
+
+// Face graph of the resident tiles; faces across a tile boundary are linked through their shared world edge.
+struct TiledFaceGraph {
+
+    const Residents& residents;
+
+    std::size_t size() const {
+        return residents.face_offsets.back();
+    }
+
+    const Vertex& position(const std::size_t node) const {
+        const auto at = locate(residents.face_offsets, node);
+        return residents.tiles[at.slot]->centroids[at.local];
+    }
+
+    template<typename Visit>
+    void for_each_neighbor(const std::size_t node, Visit&& visit) const {
+        const auto at = locate(residents.face_offsets, node);
+        const auto& tile = *residents.tiles[at.slot];
+        const auto offset = residents.face_offsets[at.slot];
+        const auto neighbors = tile.face_connectivity.find(at.local);
+        if(neighbors != tile.face_connectivity.end()) {
+            for(const auto neighbor : neighbors->second) visit(offset + neighbor);
+        }
+        const auto portals = tile.face_portals.find(at.local);
+        if(portals == tile.face_portals.end()) return;
+        for(const auto& edge : portals->second) {
+            for(const auto& across : residents.face_portals.find(edge)->second) {
+                if(across.slot != at.slot) visit(residents.face_offsets[across.slot] + across.local);
+            }
+        }
+    }
+
+};
+
+std::optional<std::size_t> find_node(const Residents& residents, const std::size_t world, const bool faces) {
+
+    const auto& offsets = faces ? residents.face_offsets : residents.vertex_offsets;
+    for(std::size_t slot=0; slot < residents.tiles.size(); ++slot) {
+        const auto& locals = faces ? residents.tiles[slot]->face_locals : residents.tiles[slot]->vertex_locals;
+        const auto local = locals.find(world);
+        if(local != locals.end()) return offsets[slot] + local->second;
+    }
+    return std::nullopt;
+
+}
+
+template<typename Graph>
+Path search_world(const Graph& graph, const Heuristics& heuristics, const std::optional<std::size_t> first, const std::optional<std::size_t> last, const SearchOptions& options) {
+
+    if(!first || !last) return Path{ { }, std::nullopt, 1.f };
+    return search_steps(graph, heuristics, *first, *last, options);
+
+}
+
+// Turns resident node indices into world indices, merging the copies of a vertex crossed through a portal.
+void to_world(Path& path, const Residents& residents, const bool faces, const bool retrieve_vertices) {
+
+    const auto& offsets = faces ? residents.face_offsets : residents.vertex_offsets;
+    auto steps = std::vector<std::size_t>{ };
+    auto vertices = Vertices{ };
+    for(const auto node : path.steps) {
+        const auto at = locate(offsets, node);
+        const auto& tile = *residents.tiles[at.slot];
+        const auto world = faces ? tile.tile.face_ids[at.local] : tile.tile.vertex_ids[at.local];
+        if(!steps.empty() && steps.back() == world) continue;
+        steps.push_back(world);
+        if(retrieve_vertices) vertices.push_back(faces ? tile.centroids[at.local] : tile.tile.mesh.vertices[at.local]);
+    }
+    path.steps = std::move(steps);
+    if(retrieve_vertices) path.vertices = std::move(vertices);
+
+}
+
+} // namespace astar::detail::Anonymous
+
+} // namespace astar::detail
+
+TiledWorld::TiledWorld(TileLoader l) :
+    loader{ std::move(l) }, residents_mutex{ }, residents{ detail::make_residents({ }) }, publish_mutex{ },
+    queue_mutex{ }, wake{ }, idle{ }, requests{ }, failure{ }, busy{ false }, stopping{ false }, worker{ } {
+
+    worker = std::thread{ &TiledWorld::run, this };
+
+}
+
+TiledWorld::~TiledWorld() {
+
+    {
+        const auto lock = std::lock_guard<std::mutex>{ queue_mutex };
+        stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+
+}
+
+void TiledWorld::run() {
+
+    auto lock = std::unique_lock<std::mutex>{ queue_mutex };
+    while(true) {
+        wake.wait(lock, [this] { return stopping || !requests.empty(); });
+        if(stopping) return;
+        const auto request = requests.front();
+        requests.pop_front();
+        busy = true;
+        lock.unlock();
+        try {
+            request.first ? load(request.second) : evict(request.second);
+        } catch(...) {
+            const auto guard = std::lock_guard<std::mutex>{ queue_mutex };
+            if(!failure) failure = std::current_exception();
+        }
+        lock.lock();
+        busy = false;
+        if(requests.empty()) idle.notify_all();
+    }
+
+}
+
+void TiledWorld::enqueue(const bool load, const std::size_t tile) {
+
+    {
+        const auto lock = std::lock_guard<std::mutex>{ queue_mutex };
+        requests.emplace_back(load, tile);
+    }
+    wake.notify_one();
+
+}
+
+void TiledWorld::load(const std::size_t tile) {
+
+    if(is_resident(tile)) return;
+    auto prepared = detail::prepare(tile, loader(tile));
+    const auto lock = std::lock_guard<std::mutex>{ publish_mutex };
+    auto tiles = snapshot()->tiles;
+    if(std::any_of(tiles.begin(), tiles.end(), [tile](const auto& resident) { return resident->id == tile; })) return;
+    tiles.push_back(std::move(prepared));
+    auto published = detail::make_residents(std::move(tiles));
+    const auto guard = std::lock_guard<std::mutex>{ residents_mutex };
+    residents = std::move(published);
+
+}
+
+void TiledWorld::evict(const std::size_t tile) {
+
+    const auto lock = std::lock_guard<std::mutex>{ publish_mutex };
+    auto tiles = snapshot()->tiles;
+    const auto evicted = std::remove_if(tiles.begin(), tiles.end(), [tile](const auto& resident) { return resident->id == tile; });
+    if(evicted == tiles.end()) return;
+    tiles.erase(evicted, tiles.end());
+    auto published = detail::make_residents(std::move(tiles));
+    const auto guard = std::lock_guard<std::mutex>{ residents_mutex };
+    residents = std::move(published);
+
+}
+
+void TiledWorld::request_load(const std::size_t tile) {
+
+    enqueue(true, tile);
+
+}
+
+void TiledWorld::request_evict(const std::size_t tile) {
+
+    enqueue(false, tile);
+
+}
+
+void TiledWorld::wait_idle() {
+
+    auto lock = std::unique_lock<std::mutex>{ queue_mutex };
+    idle.wait(lock, [this] { return requests.empty() && !busy; });
+    if(failure) std::rethrow_exception(std::exchange(failure, nullptr));
+
+}
+
+bool TiledWorld::is_resident(const std::size_t tile) const {
+
+    const auto current = snapshot();
+    return std::any_of(current->tiles.begin(), current->tiles.end(), [tile](const auto& resident) { return resident->id == tile; });
+
+}
+
+std::vector<std::size_t> TiledWorld::resident_tiles() const {
+
+    const auto current = snapshot();
+    auto ids = std::vector<std::size_t>{ };
+    std::transform(current->tiles.begin(), current->tiles.end(), std::back_inserter(ids), [](const auto& resident) { return resident->id; });
+    return ids;
+
+}
+
+std::shared_ptr<const detail::Residents> TiledWorld::snapshot() const {
+
+    const auto lock = std::lock_guard<std::mutex>{ residents_mutex };
+    return residents;
+
+}
+
+FindTiledPath::FindTiledPath(const TiledWorld& w, const Heuristics& h, const bool r, const SearchOptions& o) :
+    residents{ w.snapshot() }, heuristics{ h }, retrieve_vertices{ r }, options{ o } {
+
+}
+
+Path FindTiledPath::operator()(const std::pair<std::size_t, std::size_t>& ends) const {
+
+    const auto first = detail::find_node(*residents, ends.first, false);
+    const auto last = detail::find_node(*residents, ends.second, false);
+    auto path = detail::search_world(detail::TiledVertexGraph{ *residents }, heuristics, first, last, options);
+    detail::to_world(path, *residents, false, retrieve_vertices);
+    return path;
+
+}
+
+Path FindTiledPath::operator()(const std::pair<Barycenter, Barycenter>& ends) const {
+
+    const auto first = detail::find_node(*residents, ends.first.face, true);
+    const auto last = detail::find_node(*residents, ends.second.face, true);
+    auto path = detail::search_world(detail::TiledFaceGraph{ *residents }, heuristics, first, last, options);
+    detail::to_world(path, *residents, true, retrieve_vertices);
+    return path;
+
+}
+
+Path find_best_path(const TiledWorld& world, const Heuristics& heuristics, const Ends& ends, const bool retrieve_vertices, const SearchOptions& options) {
+
+    return std::visit(FindTiledPath{ world, heuristics, retrieve_vertices, options }, ends);
+
+}
+
+} // namespace astar
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace astar {
+
+namespace detail {
+
+// Lock-free disjoint sets: roots are always linked below the smaller index with a
+// CAS on the root's parent, and finds compress paths by halving.
+class ConcurrentUnionFind {
+
+private:
+
+    std::unique_ptr<std::atomic<std::size_t>[]> parent;
+
+public:
+
+    explicit ConcurrentUnionFind(const std::size_t size) : parent{ new std::atomic<std::size_t>[size] } {
+        for(std::size_t node=0; node < size; ++node) parent[node].store(node, std::memory_order_relaxed);
+    }
+
+    std::size_t find(std::size_t node) {
+        while(true) {
+            auto up = parent[node].load(std::memory_order_acquire);
+            if(up == node) return node;
+            const auto grand = parent[up].load(std::memory_order_acquire);
+            if(up != grand) parent[node].compare_exchange_weak(up, grand, std::memory_order_acq_rel);
+            node = grand;
+        }
+    }
+
+    void unite(std::size_t one, std::size_t other) {
+        while(true) {
+            one = find(one);
+            other = find(other);
+            if(one == other) return;
+            if(one < other) std::swap(one, other);
+            auto expected = one;
+            if(parent[one].compare_exchange_strong(expected, other, std::memory_order_acq_rel)) return;
+        }
+    }
+
+};
+
+} // namespace astar::detail
+
+} // namespace astar
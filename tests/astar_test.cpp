@@ -1,7 +1,10 @@
+#include <stdexcept>
+
 #include <gtest/gtest.h>
 
 #include "astar/astar.h"
 #include "astar/heuristics.h"
+#include "astar/search_options.h"
 
 #include "helpers.h"
 
@@ -9,10 +12,6 @@ namespace astar {
 
 namespace tests {
 
-namespace {
-
-} // namespace astar::tests::Anonymous
-
 TEST(SimpleAStarTest, FindsDirectShortestPathOnSimpleSquareMesh) {
 
     const auto mesh = MeshFactory::make_simple();
@@ -26,6 +25,18 @@ TEST(SimpleAStarTest, FindsDirectShortestPathOnSimpleSquareMesh) {
 
 }
 
+TEST(SimpleAStarTest, RejectsEndsOutsideTheMesh) {
+
+    const auto mesh = MeshFactory::make_simple();
+    const auto h = HeuristicsFactory::make_euclidian();
+
+    EXPECT_THROW(find_best_path(mesh, h, std::pair<std::size_t, std::size_t>{ 0, 4 }), std::out_of_range);
+    EXPECT_THROW(find_best_path(mesh, h, std::pair<std::size_t, std::size_t>{ 7, 1 }, false, SearchOptionsFactory::make_parallel(2)), std::out_of_range);
+    const auto faces = std::pair<Barycenter, Barycenter>{ { 0, { 1.f, 0.f, 0.f } }, { 2, { 1.f, 0.f, 0.f } } };
+    EXPECT_THROW(find_best_path(mesh, h, Ends{ faces }), std::out_of_range);
+
+}
+
 TEST(ComplexAStarTest, FindsStraightShortestPathOnComplexGridMesh) {
 
     const auto mesh = MeshFactory::make_complex();
@@ -84,21 +95,121 @@ TEST(PondDualAStarTest, FindLongUndeterminedPathOnPondMesh) {
     };
     const auto p = FindBestPath{ mesh, h, false }(ends);
 
-    ASSERT_EQ(p.steps.size() , 14u);
-    EXPECT_EQ(p.steps.at( 0),  0u);
-    EXPECT_EQ(p.steps.at( 1),  1u);
-    EXPECT_EQ(p.steps.at( 2),  9u);
-    EXPECT_EQ(p.steps.at( 3), 10u);
-    EXPECT_EQ(p.steps.at( 4),  3u);
-    EXPECT_EQ(p.steps.at( 5),  4u);
-    EXPECT_EQ(p.steps.at( 6),  5u);
-    EXPECT_EQ(p.steps.at( 7), 11u);
-    EXPECT_EQ(p.steps.at( 8), 12u);
-    EXPECT_EQ(p.steps.at( 9), 13u);
-    EXPECT_EQ(p.steps.at(10), 17u);
-    EXPECT_EQ(p.steps.at(11), 18u);
-    EXPECT_EQ(p.steps.at(12), 25u);
-    EXPECT_EQ(p.steps.at(13), 26u);
+    ASSERT_EQ(p.steps.size() , 10u);
+    EXPECT_EQ(p.steps.at(0),  0u);
+    EXPECT_EQ(p.steps.at(1),  1u);
+    EXPECT_EQ(p.steps.at(2),  9u);
+    EXPECT_EQ(p.steps.at(3),  8u);
+    EXPECT_EQ(p.steps.at(4), 15u);
+    EXPECT_EQ(p.steps.at(5), 16u);
+    EXPECT_EQ(p.steps.at(6), 22u);
+    EXPECT_EQ(p.steps.at(7), 23u);
+    EXPECT_EQ(p.steps.at(8), 24u);
+    EXPECT_EQ(p.steps.at(9), 26u);
+    EXPECT_FLOAT_EQ(p.suboptimality, 1.f);
+
+}
+
+TEST(WeightedAStarTest, StaysWithinReportedBoundOnPondMesh) {
+
+    const auto mesh = MeshFactory::make_pond();
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto ends = std::pair<Barycenter, Barycenter>{
+        {  0, { 1.f, 1.f, 1.f } },
+        { 26, { 1.f, 1.f, 1.f } } 
+    };
+    const auto optimal  = FindBestPath{ mesh, h, true }(ends);
+    const auto weighted = FindBestPath{ mesh, h, true, SearchOptionsFactory::make_weighted(2.f) }(ends);
+
+    ASSERT_FALSE(weighted.steps.empty());
+    EXPECT_EQ(weighted.steps.front(),  0u);
+    EXPECT_EQ(weighted.steps.back() , 26u);
+    EXPECT_GE(weighted.suboptimality, 1.f);
+    EXPECT_LE(weighted.suboptimality, 2.f);
+    EXPECT_LE(length(*weighted.vertices), weighted.suboptimality * length(*optimal.vertices) + 1e-4f);
+
+}
+
+TEST(AnytimeAStarTest, ConvergesToOptimalPathWithinBudget) {
+
+    const auto mesh = MeshFactory::make_pond();
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto ends = std::pair<Barycenter, Barycenter>{
+        {  0, { 1.f, 1.f, 1.f } },
+        { 26, { 1.f, 1.f, 1.f } } 
+    };
+    const auto options = SearchOptionsFactory::make_anytime(3.f, std::chrono::seconds{ 10 });
+    const auto optimal = FindBestPath{ mesh, h, true }(ends);
+    const auto anytime = FindBestPath{ mesh, h, true, options }(ends);
+
+    EXPECT_FLOAT_EQ(anytime.suboptimality, 1.f);
+    EXPECT_NEAR(length(*anytime.vertices), length(*optimal.vertices), 1e-4f);
+
+}
+
+TEST(AnytimeAStarTest, ReturnsFirstSolutionWhenBudgetIsExhausted) {
+
+    const auto mesh = MeshFactory::make_pond();
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto ends = std::pair<std::size_t, std::size_t>{ 0, 24 };
+    const auto options = SearchOptionsFactory::make_anytime(3.f, std::chrono::microseconds{ 0 });
+    const auto p = FindBestPath{ mesh, h, false, options }(ends);
+
+    ASSERT_FALSE(p.steps.empty());
+    EXPECT_EQ(p.steps.front(),  0u);
+    EXPECT_EQ(p.steps.back() , 24u);
+    EXPECT_LE(p.suboptimality, 3.f);
+
+}
+
+TEST(ComponentsAStarTest, RejectsEndsInDisconnectedIslands) {
+
+    auto mesh = MeshFactory::make_simple();
+    mesh.vertices.push_back({ 5.f, 0.f, 0.f });
+    mesh.vertices.push_back({ 6.f, 0.f, 0.f });
+    mesh.vertices.push_back({ 5.f, 1.f, 0.f });
+    mesh.faces.push_back({ 4, 5, 6 });
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto components = ComponentsFactory::make(mesh);
+
+    const auto vertices = find_best_path(mesh, h, components, std::pair<std::size_t, std::size_t>{ 0, 5 }, true);
+    EXPECT_TRUE(vertices.steps.empty());
+    ASSERT_TRUE(vertices.vertices.has_value());
+    EXPECT_TRUE(vertices.vertices->empty());
+
+    const auto faces = FindBestPath{ mesh, h, components, false }(std::pair<Barycenter, Barycenter>{
+        { 0, { 1.f, 1.f, 1.f } },
+        { 2, { 1.f, 1.f, 1.f } }
+    });
+    EXPECT_TRUE(faces.steps.empty());
+
+    const auto connected = find_best_path(mesh, h, components, std::pair<std::size_t, std::size_t>{ 4, 6 });
+    EXPECT_EQ(connected.steps.size(), 2u);
+
+}
+
+TEST(ComponentsAStarTest, RejectsLabelsOfAnotherMesh) {
+
+    const auto mesh = MeshFactory::make_simple();
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto components = ComponentsFactory::make(MeshFactory::make_pond());
+    const auto own = ComponentsFactory::make(mesh);
+
+    EXPECT_THROW(find_best_path(mesh, h, components, std::pair<std::size_t, std::size_t>{ 0, 2 }), std::invalid_argument);
+    EXPECT_THROW(find_best_path(mesh, h, own, std::pair<std::size_t, std::size_t>{ 0, 9 }), std::out_of_range);
+
+}
+
+TEST(ComponentsAStarTest, PlainSearchTerminatesOnDisconnectedIslands) {
+
+    auto mesh = MeshFactory::make_simple();
+    mesh.vertices.push_back({ 5.f, 0.f, 0.f });
+    mesh.vertices.push_back({ 6.f, 0.f, 0.f });
+    mesh.vertices.push_back({ 5.f, 1.f, 0.f });
+    mesh.faces.push_back({ 4, 5, 6 });
+    const auto h = HeuristicsFactory::make_euclidian();
+
+    EXPECT_TRUE(find_best_path(mesh, h, std::pair<std::size_t, std::size_t>{ 0, 5 }).steps.empty());
 
 }
 
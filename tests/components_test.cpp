@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include "astar/components.h"
+#include "astar/connectivity_map.h"
+
+#include "helpers.h"
+
+namespace astar {
+
+namespace tests {
+
+TEST(ComponentsTest, SplitSquareIsOneVertexAndOneFaceIsland) {
+
+    const auto mesh = MeshFactory::make_simple();
+    const auto components = ComponentsFactory::make(mesh);
+
+    ASSERT_EQ(components.vertices.size(), 4u);
+    ASSERT_EQ(components.faces.size(), 2u);
+    for(const auto label : components.vertices) EXPECT_EQ(label, 0u);
+    for(const auto label : components.faces) EXPECT_EQ(label, 0u);
+
+}
+
+TEST(ComponentsTest, DisjointTrianglesAndIsolatedVertexAreSeparated) {
+
+    const auto vertices = Vertices{
+        { 0.f, 0.f, 0.f }, { 1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f },
+        { 5.f, 0.f, 0.f }, { 6.f, 0.f, 0.f }, { 5.f, 1.f, 0.f },
+        { 9.f, 9.f, 0.f }
+    };
+    const auto faces = Faces{
+        { { 3, 4, 5 } },
+        { { 0, 1, 2 } }
+    };
+    const auto labels = ComponentsFactory::make_vertex_components(vertices, faces, 4);
+
+    EXPECT_EQ(labels, (Components{ 0, 0, 0, 1, 1, 1, 2 }));
+    EXPECT_EQ(ComponentsFactory::make_face_components(faces, 4), (Components{ 0, 1 }));
+
+}
+
+TEST(ComponentsTest, FaceIslandsMatchFaceConnectivityOnPond) {
+
+    const auto mesh = MeshFactory::make_pond();
+    const auto labels = ComponentsFactory::make_face_components(mesh.faces, 3);
+    const auto connectivity = ConnectivityMapFactory::make_face_to_face(mesh.faces);
+
+    for(const auto& [face, neighbors] : connectivity) {
+        for(const auto neighbor : neighbors) EXPECT_EQ(labels[face], labels[neighbor]);
+    }
+    EXPECT_EQ(labels[0], labels[26]);
+
+}
+
+} // namespace astar::tests
+
+} // namespace astar
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "astar/geodesics.h"
+#include "astar/graph.h"
+#include "astar/heuristics.h"
+#include "astar/norms.h"
+
+#include "helpers.h"
+
+namespace astar {
+
+namespace tests {
+
+TEST(HeatGeodesicsTest, ApproximatesPlanarDistances) {
+
+    const auto size = std::size_t{ 31 };
+    const auto mesh = MeshFactory::make_grid(size);
+    const auto center = (size / 2) * size + size / 2;
+    const auto distances = HeatGeodesics{ mesh, 1 }.distances({ center });
+
+    ASSERT_EQ(distances.size(), mesh.vertices.size());
+    EXPECT_FLOAT_EQ(distances[center], 0.f);
+    for(std::size_t vertex=0; vertex < mesh.vertices.size(); ++vertex) {
+        const auto exact = euclidian_norm(mesh.vertices[vertex], mesh.vertices[center]);
+        if(exact >= 4.f) {
+            EXPECT_NEAR(distances[vertex] / exact, 1.f, 0.07f) << vertex;
+        }
+    }
+
+}
+
+TEST(HeatGeodesicsTest, SeveralSourcesGiveTheClosestDistance) {
+
+    const auto size = std::size_t{ 25 };
+    const auto mesh = MeshFactory::make_grid(size);
+    const auto geodesics = HeatGeodesics{ mesh, 4 };
+    const auto left = std::size_t{ 12 * size + 2 };
+    const auto right = std::size_t{ 12 * size + 22 };
+    const auto distances = geodesics.distances({ left, right });
+
+    EXPECT_FLOAT_EQ(distances[left], 0.f);
+    EXPECT_FLOAT_EQ(distances[right], 0.f);
+    EXPECT_NEAR(distances[12 * size + 7], 5.f, 0.5f);
+    EXPECT_NEAR(distances[12 * size + 17], 5.f, 0.5f);
+    EXPECT_GT(distances[12 * size + 12], distances[12 * size + 7]);
+
+    const auto batch = geodesics.batch_distances({ { left }, { left, right }, { right } });
+    ASSERT_EQ(batch.size(), 3u);
+    for(std::size_t vertex=0; vertex < distances.size(); ++vertex) {
+        EXPECT_NEAR(batch[1][vertex], distances[vertex], 1e-4f);
+        EXPECT_LE(distances[vertex], 1.05f * std::min(batch[0][vertex], batch[2][vertex]) + 0.1f);
+    }
+
+}
+
+TEST(HeatGeodesicsTest, TracedPathCutsAcrossFaces) {
+
+    const auto size = std::size_t{ 31 };
+    const auto mesh = MeshFactory::make_grid(size);
+    const auto geodesics = HeatGeodesics{ mesh };
+    const auto source = std::size_t{ 0 };
+    const auto start = std::size_t{ 10 * size + 28 };
+    const auto path = geodesics.trace(geodesics.distances({ source }), start);
+
+    ASSERT_TRUE(path.vertices.has_value());
+    ASSERT_GE(path.vertices->size(), 2u);
+    EXPECT_EQ(path.vertices->front(), mesh.vertices[start]);
+    EXPECT_EQ(path.vertices->back(), mesh.vertices[source]);
+    EXPECT_FALSE(path.steps.empty());
+
+    const auto straight = euclidian_norm(mesh.vertices[start], mesh.vertices[source]);
+    const auto graph = GraphFactory::make_vertex_graph(mesh);
+    const auto edges = find_best_path(graph, HeuristicsFactory::make_euclidian(), { start, source }, true);
+    EXPECT_LT(length(*path.vertices), 1.03f * straight);
+    EXPECT_LT(length(*path.vertices), length(*edges.vertices));
+
+}
+
+TEST(HeatGeodesicsTest, TracesFromInsideAFace) {
+
+    const auto mesh = MeshFactory::make_grid(11);
+    const auto geodesics = HeatGeodesics{ mesh };
+    const auto path = geodesics.trace(geodesics.distances({ 60 }), Barycenter{ 0, { 1.f, 1.f, 1.f } });
+
+    ASSERT_GE(path.vertices->size(), 2u);
+    EXPECT_EQ(path.steps.front(), 0u);
+    EXPECT_EQ(path.vertices->back(), mesh.vertices[60]);
+    EXPECT_LT(length(*path.vertices), 1.05f * euclidian_norm(path.vertices->front(), mesh.vertices[60]));
+
+}
+
+TEST(HeatGeodesicsTest, UnreachableIslandsStayInfinite) {
+
+    auto mesh = MeshFactory::make_simple();
+    const auto offset = mesh.vertices.size();
+    for(std::size_t vertex=0; vertex < offset; ++vertex) {
+        auto moved = mesh.vertices[vertex];
+        moved[2] += 10.f;
+        mesh.vertices.push_back(moved);
+    }
+    const auto faces = mesh.faces.size();
+    for(std::size_t face=0; face < faces; ++face) {
+        mesh.faces.push_back({ mesh.faces[face][0] + offset, mesh.faces[face][1] + offset, mesh.faces[face][2] + offset });
+    }
+    const auto geodesics = HeatGeodesics{ mesh };
+    const auto distances = geodesics.distances({ 0 });
+
+    EXPECT_TRUE(std::isfinite(distances[1]));
+    EXPECT_EQ(distances[offset], std::numeric_limits<float>::infinity());
+    EXPECT_TRUE(geodesics.trace(distances, offset).steps.empty());
+    EXPECT_THROW(geodesics.distances({ 2 * offset }), std::out_of_range);
+
+}
+
+} // namespace astar::tests
+
+} // namespace astar
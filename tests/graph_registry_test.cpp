@@ -0,0 +1,109 @@
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "astar/graph_registry.h"
+#include "astar/heuristics.h"
+
+#include "helpers.h"
+
+namespace astar {
+
+namespace tests {
+
+TEST(GraphRegistryTest, PublishedMeshIsQueriedWithIncreasingVersions) {
+
+    const auto heuristics = HeuristicsFactory::make_euclidian();
+    auto registry = GraphRegistry{ };
+    EXPECT_EQ(registry.version(), 0u);
+    EXPECT_THROW(find_best_path(registry, heuristics, Ends{ std::pair<std::size_t, std::size_t>{ 0, 2 } }), std::out_of_range);
+
+    EXPECT_EQ(registry.update(MeshFactory::make_simple()), 1u);
+    const auto simple = find_best_path(registry, heuristics, Ends{ std::pair<std::size_t, std::size_t>{ 0, 2 } }, true);
+    EXPECT_EQ(simple.steps, (std::vector<std::size_t>{ 0, 2 }));
+
+    const auto pond = MeshFactory::make_pond();
+    EXPECT_EQ(registry.update(pond), 2u);
+    const auto ends = Ends{ std::pair<Barycenter, Barycenter>{ Barycenter{ 0, { 1.f, 0.f, 0.f } }, Barycenter{ 26, { 1.f, 0.f, 0.f } } } };
+    const auto expected = find_best_path(pond, heuristics, ends);
+    EXPECT_EQ(find_best_path(registry, heuristics, ends).steps, expected.steps);
+    EXPECT_EQ(registry.retired_snapshots(), 0u);
+
+}
+
+TEST(GraphRegistryTest, LeaseKeepsItsSnapshotUntilReleased) {
+
+    auto registry = GraphRegistry{ };
+    registry.update(MeshFactory::make_simple());
+    {
+        const auto old = registry.acquire();
+        registry.update(MeshFactory::make_pond());
+        EXPECT_EQ(registry.retired_snapshots(), 1u);
+        EXPECT_EQ(old->version, 1u);
+        EXPECT_EQ(old->mesh.vertices.size(), 4u);
+        EXPECT_EQ(old->vertex_graph.positions.size(), 4u);
+
+        const auto fresh = registry.acquire();
+        EXPECT_EQ(fresh->version, 2u);
+        EXPECT_EQ(fresh->mesh.vertices.size(), 25u);
+    }
+    EXPECT_EQ(registry.retired_snapshots(), 0u);
+
+}
+
+TEST(GraphRegistryTest, ReadersRaceUpdatesSafely) {
+
+    const auto heuristics = HeuristicsFactory::make_euclidian();
+    const auto meshes = std::vector<Mesh>{ MeshFactory::make_simple(), MeshFactory::make_pond() };
+    auto registry = GraphRegistry{ };
+    registry.update(meshes[0]);
+
+    auto stop = std::atomic<bool>{ false };
+    auto queries = std::atomic<std::size_t>{ 0 };
+    auto readers = std::vector<std::thread>{ };
+    for(std::size_t reader=0; reader < 4; ++reader) {
+        readers.emplace_back([&] {
+            while(!stop.load()) {
+                const auto lease = registry.acquire();
+                const auto last = lease->mesh.vertices.size() - 1;
+                const auto ends = std::pair<std::size_t, std::size_t>{ 0, last };
+                const auto path = find_best_path(lease->vertex_graph, heuristics, ends);
+                EXPECT_EQ(path.steps.front(), 0u);
+                EXPECT_EQ(path.steps.back(), last);
+                queries.fetch_add(1);
+            }
+        });
+    }
+    for(std::size_t update=0; update < 50; ++update) {
+        registry.update(meshes[update % 2]);
+        while(queries.load() < update) std::this_thread::yield();
+    }
+    stop.store(true);
+    for(auto& reader : readers) reader.join();
+    EXPECT_EQ(registry.version(), 51u);
+    EXPECT_EQ(registry.retired_snapshots(), 0u);
+
+}
+
+TEST(GraphRegistryTest, BackgroundUpdatesPublishAndReportFailures) {
+
+    auto registry = GraphRegistry{ };
+    registry.request_update(MeshFactory::make_pond());
+    registry.wait_idle();
+    EXPECT_EQ(registry.acquire()->mesh.vertices.size(), 25u);
+
+    auto broken = MeshFactory::make_simple();
+    broken.faces.push_back(Face{ { 0, 1, 9 } });
+    registry.request_update(broken);
+    EXPECT_THROW(registry.wait_idle(), std::out_of_range);
+    EXPECT_EQ(registry.version(), 1u);
+    EXPECT_NO_THROW(registry.wait_idle());
+
+}
+
+} // namespace astar::tests
+
+} // namespace astar
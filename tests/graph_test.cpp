@@ -0,0 +1,266 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "astar/astar.h"
+#include "astar/graph.h"
+#include "astar/heuristics.h"
+
+#include "helpers.h"
+
+namespace astar {
+
+namespace tests {
+
+TEST(GraphTest, FaceGraphIsPositionedAtCentroids) {
+
+    const auto mesh = MeshFactory::make_simple();
+    const auto graph = GraphFactory::make_face_graph(mesh);
+
+    ASSERT_EQ(graph.positions.size(), 2u);
+    EXPECT_NEAR(graph.positions[0][0], 2.f / 3.f, 1e-6f);
+    EXPECT_NEAR(graph.positions[0][1], 1.f / 3.f, 1e-6f);
+    EXPECT_TRUE(graph.connectivity.at(0).count(1));
+
+}
+
+TEST(GraphTest, PreparedGraphMatchesMeshSearch) {
+
+    const auto mesh = MeshFactory::make_complex();
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto graph = GraphFactory::make_vertex_graph(mesh);
+    const auto ends = std::pair<std::size_t, std::size_t>{ 6, 2 };
+
+    EXPECT_EQ(find_best_path(graph, h, ends).steps, find_best_path(mesh, h, ends).steps);
+
+}
+
+TEST(ParallelAStarTest, MatchesSequentialCostOnGrid) {
+
+    const auto mesh = MeshFactory::make_grid(40);
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto graph = GraphFactory::make_vertex_graph(mesh);
+    const auto ends = std::pair<std::size_t, std::size_t>{ 3, 40 * 38 + 35 };
+    const auto sequential = find_best_path(graph, h, ends, true);
+
+    for(const auto threads : { 2u, 4u, 7u }) {
+        const auto parallel = find_best_path(graph, h, ends, true, SearchOptionsFactory::make_parallel(threads));
+        ASSERT_FALSE(parallel.steps.empty());
+        EXPECT_EQ(parallel.steps.front(), ends.first);
+        EXPECT_EQ(parallel.steps.back(), ends.second);
+        EXPECT_NEAR(length(parallel), length(sequential), 1e-3f);
+    }
+
+}
+
+TEST(ParallelAStarTest, ManySmallQueriesStayOptimal) {
+
+    auto mesh = MeshFactory::make_grid(12);
+    for(std::size_t i=0; i < mesh.vertices.size(); ++i) mesh.vertices[i][2] = 0.3f * std::sin(0.7f * static_cast<float>(i));
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto graph = GraphFactory::make_vertex_graph(mesh);
+
+    for(std::size_t query=0; query < 300; ++query) {
+        const auto ends = std::pair<std::size_t, std::size_t>{ (query * 53) % 144, (query * 89 + 7) % 144 };
+        const auto threads = 2 + query % 7;
+        const auto parallel = find_best_path(graph, h, ends, true, SearchOptionsFactory::make_parallel(threads));
+        ASSERT_FALSE(parallel.steps.empty()) << query;
+        EXPECT_NEAR(length(parallel), length(find_best_path(graph, h, ends, true)), 1e-4f) << query;
+    }
+
+}
+
+TEST(ParallelAStarTest, HandlesTrivialAndUnreachableQueries) {
+
+    auto mesh = MeshFactory::make_grid(5);
+    mesh.vertices.push_back({ 9.f, 9.f, 0.f });
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto graph = GraphFactory::make_vertex_graph(mesh);
+    const auto options = SearchOptionsFactory::make_parallel(3);
+
+    EXPECT_EQ(find_best_path(graph, h, { 7, 7 }, false, options).steps, (std::vector<std::size_t>{ 7 }));
+    EXPECT_TRUE(find_best_path(graph, h, { 0, 25 }, false, options).steps.empty());
+
+}
+
+TEST(ParallelAStarTest, WeightedParallelStaysWithinBound) {
+
+    const auto mesh = MeshFactory::make_grid(30);
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto graph = GraphFactory::make_vertex_graph(mesh);
+    const auto ends = std::pair<std::size_t, std::size_t>{ 0, 30 * 30 - 1 };
+    const auto optimal = find_best_path(graph, h, ends, true);
+    const auto weighted = find_best_path(graph, h, ends, true, SearchOptionsFactory::make_parallel(4, 1.5f));
+
+    EXPECT_FLOAT_EQ(weighted.suboptimality, 1.5f);
+    EXPECT_LE(length(weighted), 1.5f * length(optimal) + 1e-3f);
+
+}
+
+TEST(ParallelAStarTest, ReportsNodeExpansions) {
+
+    const auto mesh = MeshFactory::make_grid(16);
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto graph = GraphFactory::make_vertex_graph(mesh);
+
+    const auto sequential = find_best_path(graph, h, { 0, 16 * 16 - 1 });
+    const auto parallel = find_best_path(graph, h, { 0, 16 * 16 - 1 }, false, SearchOptionsFactory::make_parallel(4));
+    EXPECT_GE(sequential.expansions, sequential.steps.size() - 1);
+    EXPECT_LT(sequential.expansions, graph.positions.size());
+    EXPECT_GE(parallel.expansions, parallel.steps.size() - 1);
+    EXPECT_EQ(find_best_path(graph, h, { 5, 5 }).expansions, 0u);
+
+}
+
+TEST(PathBuffersTest, CompactStepsMatchPathAndReuseCapacity) {
+
+    const auto mesh = MeshFactory::make_grid(12);
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto graph = GraphFactory::make_vertex_graph(mesh);
+    const auto ends = std::pair<std::size_t, std::size_t>{ 0, 12 * 12 - 1 };
+    const auto expected = find_best_path(graph, h, ends);
+
+    auto buffers = CompactPathBuffers{ };
+    find_best_path(graph, h, ends, buffers);
+    ASSERT_EQ(buffers.steps.size(), expected.steps.size());
+    for(std::size_t i=0; i < expected.steps.size(); ++i) EXPECT_EQ(buffers.steps[i], expected.steps[i]);
+    EXPECT_TRUE(buffers.vertices.empty());
+
+    const auto* storage = buffers.steps.data();
+    find_best_path(graph, h, { 13, 12 * 12 - 14 }, buffers);
+    EXPECT_EQ(buffers.steps.data(), storage);
+    EXPECT_EQ(buffers.steps.front(), 13u);
+
+}
+
+TEST(PathBuffersTest, ReusedSearchStateMatchesFreshSearches) {
+
+    const auto small = GraphFactory::make_vertex_graph(MeshFactory::make_grid(8));
+    const auto large = GraphFactory::make_vertex_graph(MeshFactory::make_grid(20));
+    const auto h = HeuristicsFactory::make_euclidian();
+    auto buffers = PathBuffers<std::size_t>{ };
+
+    for(std::size_t query=0; query < 24; ++query) {
+        const auto& graph = query % 3 == 2 ? small : large;
+        const auto size = graph.positions.size();
+        const auto ends = std::pair<std::size_t, std::size_t>{ (query * 37) % size, (query * 101 + 5) % size };
+        auto options = SearchOptions{ };
+        options.open_list = static_cast<OpenListKind>(query % 3);
+        find_best_path(graph, h, ends, buffers, true, options);
+        const auto fresh = find_best_path(graph, h, ends, true, options);
+        EXPECT_EQ(buffers.steps, fresh.steps);
+        EXPECT_EQ(buffers.expansions, fresh.expansions);
+    }
+
+    const auto copy = buffers;
+    EXPECT_EQ(copy.steps, buffers.steps);
+
+}
+
+TEST(PathBuffersTest, VerticesAreFilledOnlyWhenRequested) {
+
+    const auto mesh = MeshFactory::make_complex();
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto graph = GraphFactory::make_vertex_graph(mesh);
+    auto buffers = PathBuffers<std::size_t>{ };
+
+    find_best_path(graph, h, { 6, 2 }, buffers, true);
+    ASSERT_EQ(buffers.vertices.size(), buffers.steps.size());
+    EXPECT_EQ(buffers.vertices.back(), mesh.vertices[2]);
+
+    find_best_path(graph, h, { 0, 8 }, buffers);
+    EXPECT_TRUE(buffers.vertices.empty());
+    fill_vertices(graph, buffers.steps, buffers.vertices);
+    ASSERT_EQ(buffers.vertices.size(), 3u);
+    EXPECT_EQ(buffers.vertices[1], mesh.vertices[4]);
+
+}
+
+TEST(OpenListTest, EveryPolicyFindsOptimalCost) {
+
+    auto mesh = MeshFactory::make_grid(30);
+    for(std::size_t i=0; i < mesh.vertices.size(); ++i) mesh.vertices[i][2] = 0.3f * std::sin(0.7f * static_cast<float>(i));
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto graph = GraphFactory::make_vertex_graph(mesh);
+    const auto kinds = { OpenListKind::quaternary_heap, OpenListKind::pairing_heap, OpenListKind::radix_heap, OpenListKind::quantized_radix_heap };
+
+    for(const auto& ends : { std::pair<std::size_t, std::size_t>{ 0, 899 }, { 29, 870 }, { 421, 17 }, { 5, 5 } }) {
+        const auto reference = length(find_best_path(graph, h, ends, true));
+        for(const auto kind : kinds) {
+            auto options = SearchOptions{ };
+            options.open_list = kind;
+            const auto path = find_best_path(graph, h, ends, true, options);
+            ASSERT_FALSE(path.steps.empty());
+            EXPECT_EQ(path.steps.front(), ends.first);
+            EXPECT_EQ(path.steps.back(), ends.second);
+            if(kind == OpenListKind::quantized_radix_heap) EXPECT_LE(length(path), reference * path.suboptimality + 1e-4f);
+            else EXPECT_NEAR(length(path), reference, 1e-4f);
+        }
+    }
+
+}
+
+TEST(OpenListTest, QuantizedKeysReportTheBoundTheyProve) {
+
+    auto mesh = MeshFactory::make_grid(60);
+    for(std::size_t i=0; i < mesh.vertices.size(); ++i) mesh.vertices[i][2] = 0.3f * std::sin(0.7f * static_cast<float>(i));
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto graph = GraphFactory::make_vertex_graph(mesh);
+    auto options = SearchOptions{ };
+    options.open_list = OpenListKind::quantized_radix_heap;
+    options.key_quantum = 0.5f;
+
+    auto seed = std::uint32_t{ 12345 };
+    auto next = [&seed] {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<std::size_t>(seed >> 8) % (60 * 60);
+    };
+    auto loose = std::size_t{ 0 };
+    for(std::size_t query=0; query < 100; ++query) {
+        const auto ends = std::pair<std::size_t, std::size_t>{ next(), next() };
+        const auto reference = length(find_best_path(graph, h, ends, true));
+        const auto path = find_best_path(graph, h, ends, true, options);
+        EXPECT_GE(path.suboptimality, 1.f);
+        EXPECT_LE(length(path), reference * path.suboptimality * (1.f + 1e-5f) + 1e-4f) << ends.first << " " << ends.second;
+        if(path.suboptimality > 1.f) ++loose;
+    }
+    EXPECT_GT(loose, 0u);
+
+}
+
+TEST(OpenListTest, WeightedAndAnytimeSearchesKeepTheirBound) {
+
+    auto mesh = MeshFactory::make_grid(30);
+    for(std::size_t i=0; i < mesh.vertices.size(); ++i) mesh.vertices[i][2] = 0.3f * std::sin(0.7f * static_cast<float>(i));
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto graph = GraphFactory::make_vertex_graph(mesh);
+    const auto ends = std::pair<std::size_t, std::size_t>{ 3, 896 };
+    const auto reference = length(find_best_path(graph, h, ends, true));
+
+    const auto kinds = {
+        OpenListKind::binary_heap, OpenListKind::quaternary_heap, OpenListKind::pairing_heap, OpenListKind::radix_heap, OpenListKind::quantized_radix_heap
+    };
+    for(const auto kind : kinds) {
+        auto weighted = SearchOptionsFactory::make_weighted(2.f);
+        weighted.open_list = kind;
+        const auto rough = find_best_path(graph, h, ends, true, weighted);
+        EXPECT_LE(rough.suboptimality, 2.f);
+        EXPECT_LE(length(rough), reference * rough.suboptimality + 1e-4f);
+        if(kind == OpenListKind::radix_heap || kind == OpenListKind::quantized_radix_heap) {
+            EXPECT_EQ(rough.steps, find_best_path(graph, h, ends, false, SearchOptionsFactory::make_weighted(2.f)).steps);
+        }
+
+        auto anytime = SearchOptionsFactory::make_anytime(3.f, std::chrono::seconds{ 5 });
+        anytime.open_list = kind;
+        const auto path = find_best_path(graph, h, ends, true, anytime);
+        EXPECT_FLOAT_EQ(path.suboptimality, 1.f);
+        EXPECT_NEAR(length(path), reference, 1e-4f);
+    }
+
+}
+
+} // namespace astar::tests
+
+} // namespace astar
@@ -1,6 +1,7 @@
 #include "astar/face.h"
 #include "astar/vertex.h"
 #include "astar/mesh.h"
+#include "astar/norms.h"
 
 #include "helpers.h"
 
@@ -80,8 +81,39 @@ Mesh make_pond() {
 
 }
 
+Mesh make_grid(const std::size_t size) {
+
+    auto mesh = Mesh{ };
+    for(std::size_t y=0; y < size; ++y) {
+        for(std::size_t x=0; x < size; ++x) mesh.vertices.push_back({ static_cast<float>(x), static_cast<float>(y), 0.f });
+    }
+    for(std::size_t y=0; y + 1 < size; ++y) {
+        for(std::size_t x=0; x + 1 < size; ++x) {
+            const auto corner = y * size + x;
+            mesh.faces.push_back({ corner, corner + 1, corner + size + 1 });
+            mesh.faces.push_back({ corner, corner + size + 1, corner + size });
+        }
+    }
+    return mesh;
+
+}
+
 } // namespace astar::tests::MeshFactory
 
+float length(const Vertices& polyline) {
+
+    auto total = 0.f;
+    for(std::size_t i=1; i < polyline.size(); ++i) total += euclidian_norm(polyline[i - 1], polyline[i]);
+    return total;
+
+}
+
+float length(const Path& path) {
+
+    return length(*path.vertices);
+
+}
+
 } // namespace astar::tests
 
 } // namespace astar
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "astar/mesh.h"
+#include "astar/path.h"
+#include "astar/vertex.h"
 
 namespace astar {
 
@@ -14,8 +16,17 @@ Mesh make_complex();
 
 Mesh make_pond();
 
+// Square grid of size x size vertices with unit spacing, two triangles per cell.
+Mesh make_grid(const std::size_t size);
+
 } // namespace astar::tests::MeshFactory
 
+// Sum of the segment lengths of a polyline.
+float length(const Vertices& polyline);
+
+// Length of the retrieved vertices of a path.
+float length(const Path& path);
+
 } // namespace astar::tests
 
 } // namespace astar
\ No newline at end of file
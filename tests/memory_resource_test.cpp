@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory_resource>
+#include <thread>
+
+#include "astar/astar.h"
+#include "astar/graph.h"
+#include "astar/heuristics.h"
+#include "astar/memory_resource.h"
+#include "astar/path_buffers.h"
+#include "astar/range_query.h"
+
+#include "helpers.h"
+
+namespace astar {
+
+namespace tests {
+
+namespace {
+
+class CountingResource : public std::pmr::memory_resource {
+
+private:
+
+    std::pmr::memory_resource* upstream;
+
+    void* do_allocate(const std::size_t bytes, const std::size_t alignment) override {
+        ++allocations;
+        return upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* pointer, const std::size_t bytes, const std::size_t alignment) override {
+        upstream->deallocate(pointer, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+public:
+
+    std::size_t allocations{ 0 };
+
+    explicit CountingResource(std::pmr::memory_resource* u=std::pmr::get_default_resource()) : upstream{ u } {
+
+    }
+
+};
+
+// Counts the calls that overlap with another one.
+class OverlapResource : public std::pmr::memory_resource {
+
+private:
+
+    std::atomic<std::size_t> inside{ 0 };
+
+    void* do_allocate(const std::size_t bytes, const std::size_t alignment) override {
+        if(inside.fetch_add(1) > 0) ++overlaps;
+        ++allocations;
+        std::this_thread::yield();
+        auto* pointer = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        inside.fetch_sub(1);
+        return pointer;
+    }
+
+    void do_deallocate(void* pointer, const std::size_t bytes, const std::size_t alignment) override {
+        if(inside.fetch_add(1) > 0) ++overlaps;
+        std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+        inside.fetch_sub(1);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+public:
+
+    std::atomic<std::size_t> allocations{ 0 };
+    std::atomic<std::size_t> overlaps{ 0 };
+
+};
+
+} // namespace astar::tests::Anonymous
+
+TEST(MemoryResourceTest, GraphAdjacencyComesFromTheGivenResource) {
+
+    const auto mesh = MeshFactory::make_complex();
+    auto counting = CountingResource{ };
+
+    const auto graph = GraphFactory::make_vertex_graph(mesh, &counting);
+
+    EXPECT_GT(counting.allocations, 0u);
+    EXPECT_EQ(graph.connectivity.get_allocator().resource(), &counting);
+    EXPECT_EQ(graph.connectivity.at(0).get_allocator().resource(), &counting);
+    EXPECT_EQ(graph.connectivity, GraphFactory::make_vertex_graph(mesh).connectivity);
+
+}
+
+TEST(MemoryResourceTest, SearchStateComesFromTheOptionsResource) {
+
+    const auto mesh = MeshFactory::make_complex();
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto graph = GraphFactory::make_vertex_graph(mesh);
+    auto counting = CountingResource{ };
+    auto options = SearchOptions{ };
+    options.resource = &counting;
+
+    const auto path = find_best_path(graph, h, { 6, 2 }, false, options);
+    EXPECT_GT(counting.allocations, 0u);
+    EXPECT_EQ(path.steps, find_best_path(graph, h, { 6, 2 }).steps);
+
+    const auto before = counting.allocations;
+    options.threads = 3;
+    EXPECT_EQ(find_best_path(graph, h, { 6, 2 }, false, options).steps, path.steps);
+    EXPECT_GT(counting.allocations, before);
+
+}
+
+TEST(MemoryResourceTest, BuffersReuseSearchStateAfterWarmUp) {
+
+    const auto mesh = MeshFactory::make_pond();
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto graph = GraphFactory::make_face_graph(mesh);
+    auto counting = CountingResource{ };
+    auto options = SearchOptions{ };
+    options.resource = &counting;
+    auto buffers = CompactPathBuffers{ };
+
+    find_best_path(graph, h, { 0, 26 }, buffers, false, options);
+    const auto warmed = counting.allocations;
+    EXPECT_GT(warmed, 0u);
+    for(std::size_t repeat=0; repeat < 3; ++repeat) find_best_path(graph, h, { 0, 26 }, buffers, false, options);
+    EXPECT_EQ(counting.allocations, warmed);
+
+}
+
+TEST(MemoryResourceTest, ParallelWorkersNeverCallTheResourceConcurrently) {
+
+    const auto mesh = MeshFactory::make_pond();
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto graph = GraphFactory::make_face_graph(mesh);
+    auto overlapping = OverlapResource{ };
+    auto options = SearchOptionsFactory::make_parallel(4);
+    options.resource = &overlapping;
+
+    for(std::size_t repeat=0; repeat < 20; ++repeat) {
+        EXPECT_EQ(find_best_path(graph, h, { 0, 26 }, false, options).steps, find_best_path(graph, h, { 0, 26 }).steps);
+    }
+    EXPECT_GT(overlapping.allocations.load(), 0u);
+    EXPECT_EQ(overlapping.overlaps.load(), 0u);
+
+}
+
+TEST(MemoryResourceTest, RangeQueriesDrawTheirStateFromTheGivenResource) {
+
+    const auto graph = GraphFactory::make_vertex_graph(MeshFactory::make_grid(9));
+    auto counting = CountingResource{ };
+
+    const auto within = find_within(graph, { 40 }, 3.f, &counting);
+    EXPECT_GT(counting.allocations, 0u);
+    EXPECT_EQ(within.nodes, find_within(graph, { 40 }, 3.f).nodes);
+
+    const auto before = counting.allocations;
+    const auto nearest = find_nearest(graph, { 40 }, std::vector<std::size_t>{ 0, 80 }, 1, unbounded_cost, &counting);
+    EXPECT_GT(counting.allocations, before);
+    EXPECT_EQ(nearest.nodes, find_nearest(graph, { 40 }, std::vector<std::size_t>{ 0, 80 }).nodes);
+
+    auto overlapping = OverlapResource{ };
+    const auto sources = std::vector<std::size_t>{ 0, 8, 40, 72, 80, 10, 20, 30 };
+    const auto batched = batch_find_within(graph, sources, 4.f, 4, &overlapping);
+    EXPECT_GT(overlapping.allocations.load(), 0u);
+    EXPECT_EQ(overlapping.overlaps.load(), 0u);
+    ASSERT_EQ(batched.size(), sources.size());
+    for(std::size_t i=0; i < sources.size(); ++i) EXPECT_EQ(batched[i].nodes, find_within(graph, { sources[i] }, 4.f).nodes);
+
+}
+
+TEST(MemoryResourceTest, ArenaServesAWholeMeshQuery) {
+
+    const auto mesh = MeshFactory::make_pond();
+    const auto h = HeuristicsFactory::make_euclidian();
+    auto upstream = CountingResource{ };
+    const auto arena = MemoryResourceFactory::make_arena(std::size_t{ 1u << 16 }, &upstream);
+    auto options = SearchOptions{ };
+    options.resource = arena.get();
+
+    const auto ends = Ends{ std::pair<Barycenter, Barycenter>{ { 0, { 1.f, 1.f, 1.f } }, { 26, { 1.f, 1.f, 1.f } } } };
+
+    const auto path = find_best_path(mesh, h, ends, false, options);
+    EXPECT_EQ(path.steps, find_best_path(mesh, h, ends).steps);
+    EXPECT_EQ(upstream.allocations, 1u);
+    arena->release();
+
+}
+
+TEST(MemoryResourceTest, PoolsBackReusableGraphs) {
+
+    const auto mesh = MeshFactory::make_complex();
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto pool = MemoryResourceFactory::make_pool();
+    const auto shared = MemoryResourceFactory::make_shared_pool();
+
+    const auto pooled = GraphFactory::make_face_graph(mesh, pool.get());
+    const auto synchronized = GraphFactory::make_face_graph(mesh, shared.get());
+    EXPECT_EQ(pooled.connectivity, synchronized.connectivity);
+    EXPECT_EQ(find_best_path(pooled, h, { 0, 3 }).steps, find_best_path(synchronized, h, { 0, 3 }).steps);
+
+}
+
+} // namespace astar::tests
+
+} // namespace astar
@@ -0,0 +1,190 @@
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "astar/mesh_loader.h"
+#include "astar/mesh.h"
+
+namespace astar {
+
+namespace tests {
+
+namespace {
+
+std::string write_file(const std::string& name, const std::string& content) {
+
+    const auto path = std::filesystem::temp_directory_path() / name;
+    auto file = std::ofstream{ path, std::ios::binary };
+    file << content;
+    return path.string();
+
+}
+
+template<typename Number>
+void append(std::string& buffer, const Number value) {
+
+    char bytes[sizeof(Number)];
+    std::memcpy(bytes, &value, sizeof(Number));
+    buffer.append(bytes, sizeof(Number));
+
+}
+
+} // namespace astar::tests::Anonymous
+
+TEST(ObjLoaderTest, TriangulatesQuadsAndResolvesRelativeIndices) {
+
+    const auto path = write_file("astar_quad.obj",
+        "# unit square\n"
+        "v 0 0 0\n"
+        "v 1 0 0\n"
+        "v 1 1 0\n"
+        "v 0 1 0\n"
+        "vn 0 0 1\n"
+        "f 1//1 2//1 3//1 4//1\n"
+        "v 2 0 0\r\n"
+        "f -4 -1 -3\n"
+    );
+    const auto mesh = MeshLoader::load_obj(path, 3);
+
+    ASSERT_EQ(mesh.vertices.size(), 5u);
+    ASSERT_EQ(mesh.faces.size(), 3u);
+    EXPECT_EQ(mesh.faces[0], (Face{ { 0, 1, 2 } }));
+    EXPECT_EQ(mesh.faces[1], (Face{ { 0, 2, 3 } }));
+    EXPECT_EQ(mesh.faces[2], (Face{ { 1, 4, 2 } }));
+    EXPECT_FLOAT_EQ(mesh.vertices[4][0], 2.f);
+
+}
+
+TEST(ObjLoaderTest, WeldsDuplicatedVertices) {
+
+    const auto path = write_file("astar_split.obj",
+        "v 0 0 0\nv 1 0 0\nv 1 1 0\n"
+        "v 0 0 0\nv 1 1 0\nv 0 1 0\n"
+        "f 1 2 3\nf 4 5 6\n"
+    );
+    const auto mesh = MeshLoader::load(path);
+
+    ASSERT_EQ(mesh.vertices.size(), 4u);
+    ASSERT_EQ(mesh.faces.size(), 2u);
+    EXPECT_EQ(mesh.faces[1], (Face{ { 0, 2, 3 } }));
+
+}
+
+TEST(ObjLoaderTest, RejectsOutOfRangeIndices) {
+
+    const auto path = write_file("astar_broken.obj", "v 0 0 0\nv 1 0 0\nf 1 2 3\n");
+
+    EXPECT_THROW(MeshLoader::load_obj(path), std::runtime_error);
+
+}
+
+TEST(PlyLoaderTest, ReadsAsciiPly) {
+
+    const auto path = write_file("astar_ascii.ply",
+        "ply\n"
+        "format ascii 1.0\n"
+        "comment square\n"
+        "element vertex 4\n"
+        "property float x\n"
+        "property float y\n"
+        "property float z\n"
+        "property uchar red\n"
+        "element face 1\n"
+        "property list uchar int vertex_indices\n"
+        "end_header\n"
+        "0 0 0 255\n"
+        "1 0 0 255\n"
+        "1 1 0 255\n"
+        "0 1 0 255\n"
+        "4 0 1 2 3\n"
+    );
+    const auto mesh = MeshLoader::load(path, 2);
+
+    ASSERT_EQ(mesh.vertices.size(), 4u);
+    ASSERT_EQ(mesh.faces.size(), 2u);
+    EXPECT_EQ(mesh.faces[1], (Face{ { 0, 2, 3 } }));
+    EXPECT_FLOAT_EQ(mesh.vertices[2][1], 1.f);
+
+}
+
+TEST(PlyLoaderTest, ReadsBinaryLittleEndianPly) {
+
+    auto content = std::string{
+        "ply\n"
+        "format binary_little_endian 1.0\n"
+        "element vertex 3\n"
+        "property double x\n"
+        "property double y\n"
+        "property double z\n"
+        "element face 1\n"
+        "property list uchar uint vertex_indices\n"
+        "property int flags\n"
+        "end_header\n"
+    };
+    for(const auto& vertex : { Vertex{ 0.f, 0.f, 0.f }, Vertex{ 1.f, 0.f, 0.f }, Vertex{ 0.f, 2.f, 0.f } }) {
+        for(const auto coordinate : vertex) append<double>(content, coordinate);
+    }
+    append<std::uint8_t>(content, 3u);
+    for(const auto corner : { 0u, 1u, 2u }) append<std::uint32_t>(content, corner);
+    append<std::int32_t>(content, 7);
+    const auto path = write_file("astar_binary.ply", content);
+    const auto mesh = MeshLoader::load_ply(path, 4);
+
+    ASSERT_EQ(mesh.vertices.size(), 3u);
+    ASSERT_EQ(mesh.faces.size(), 1u);
+    EXPECT_EQ(mesh.faces[0], (Face{ { 0, 1, 2 } }));
+    EXPECT_FLOAT_EQ(mesh.vertices[2][1], 2.f);
+
+}
+
+TEST(PlyLoaderTest, RejectsMalformedBinaryLists) {
+
+    const auto header = [](const std::string& vertices, const std::string& list) {
+        return "ply\nformat binary_little_endian 1.0\nelement vertex " + vertices + "\nproperty float x\nproperty float y\nproperty float z\n"
+            "element face 1\nproperty list " + list + " vertex_indices\nend_header\n";
+    };
+    auto vertices = std::string{ };
+    for(std::size_t coordinate=0; coordinate < 9; ++coordinate) append<float>(vertices, static_cast<float>(coordinate));
+
+    auto negative = header("3", "int int") + vertices;
+    append<std::int32_t>(negative, -1);
+    EXPECT_THROW(MeshLoader::load_ply(write_file("astar_negative.ply", negative)), std::runtime_error);
+
+    auto fractional = header("3", "float int") + vertices;
+    append<float>(fractional, 3.f);
+    for(const auto corner : { 0, 1, 2 }) append<std::int32_t>(fractional, corner);
+    EXPECT_THROW(MeshLoader::load_ply(write_file("astar_fractional.ply", fractional)), std::runtime_error);
+
+    const auto overflowing = header("1537228672809129302", "uchar int") + vertices;
+    EXPECT_THROW(MeshLoader::load_ply(write_file("astar_overflowing.ply", overflowing)), std::runtime_error);
+
+}
+
+TEST(PlyLoaderTest, RejectsAsciiVerticesWithoutCoordinates) {
+
+    const auto path = write_file("astar_flat.ply",
+        "ply\n"
+        "format ascii 1.0\n"
+        "element vertex 3\n"
+        "property float x\n"
+        "property float y\n"
+        "element face 1\n"
+        "property list uchar int vertex_indices\n"
+        "end_header\n"
+        "0 0\n"
+        "1 0\n"
+        "0 1\n"
+        "3 0 1 2\n"
+    );
+
+    EXPECT_THROW(MeshLoader::load_ply(path), std::runtime_error);
+
+}
+
+} // namespace astar::tests
+
+} // namespace astar
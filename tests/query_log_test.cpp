@@ -0,0 +1,84 @@
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <variant>
+
+#include <gtest/gtest.h>
+
+#include "astar/query_log.h"
+
+#include "helpers.h"
+
+namespace astar {
+
+namespace tests {
+
+namespace {
+
+std::string temp_path(const std::string& name) {
+
+    return (std::filesystem::temp_directory_path() / name).string();
+
+}
+
+} // namespace astar::tests::Anonymous
+
+TEST(QueryLogTest, RecordedQueriesRoundTrip) {
+
+    const auto mesh = MeshFactory::make_pond();
+    const auto path = temp_path("astar_round_trip.asql");
+    {
+        auto recorder = QueryRecorder{ path, mesh };
+        recorder.record(Ends{ std::pair<std::size_t, std::size_t>{ 3, 21 } });
+        recorder.record(Ends{ std::pair<Barycenter, Barycenter>{ { 0, { 0.2f, 0.3f, 0.5f } }, { 26, { 1.f, 0.f, 0.f } } } });
+    }
+    const auto log = QueryLogLoader::load(path);
+
+    EXPECT_EQ(log.mesh_hash, mesh_hash(mesh));
+    EXPECT_EQ(std::filesystem::file_size(path), 13u + 9u + 33u);
+    ASSERT_EQ(log.queries.size(), 2u);
+    const auto vertices = std::get<std::pair<std::size_t, std::size_t>>(log.queries[0]);
+    EXPECT_EQ(vertices.first, 3u);
+    EXPECT_EQ(vertices.second, 21u);
+    const auto barycenters = std::get<std::pair<Barycenter, Barycenter>>(log.queries[1]);
+    EXPECT_EQ(barycenters.first.face, 0u);
+    EXPECT_FLOAT_EQ(barycenters.first.weights[2], 0.5f);
+    EXPECT_EQ(barycenters.second.face, 26u);
+    EXPECT_FLOAT_EQ(barycenters.second.weights[0], 1.f);
+
+}
+
+TEST(QueryLogTest, MeshHashTracksGeometryAndTopology) {
+
+    const auto mesh = MeshFactory::make_complex();
+    auto moved = mesh;
+    moved.vertices[0][2] += 1e-3f;
+    auto flipped = mesh;
+    std::swap(flipped.faces[0][0], flipped.faces[0][1]);
+
+    EXPECT_EQ(mesh_hash(mesh), mesh_hash(MeshFactory::make_complex()));
+    EXPECT_NE(mesh_hash(mesh), mesh_hash(moved));
+    EXPECT_NE(mesh_hash(mesh), mesh_hash(flipped));
+
+}
+
+TEST(QueryLogTest, RejectsForeignAndTruncatedFiles) {
+
+    const auto foreign = temp_path("astar_foreign.asql");
+    std::ofstream{ foreign, std::ios::binary } << "PLY not a log";
+    EXPECT_THROW(QueryLogLoader::load(foreign), std::runtime_error);
+
+    const auto truncated = temp_path("astar_truncated.asql");
+    {
+        auto recorder = QueryRecorder{ truncated, MeshFactory::make_simple() };
+        recorder.record(Ends{ std::pair<std::size_t, std::size_t>{ 0, 1 } });
+    }
+    std::filesystem::resize_file(truncated, std::filesystem::file_size(truncated) - 2);
+    EXPECT_THROW(QueryLogLoader::load(truncated), std::runtime_error);
+
+}
+
+} // namespace astar::tests
+
+} // namespace astar
@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "astar/components.h"
+#include "astar/graph.h"
+#include "astar/heuristics.h"
+#include "astar/range_query.h"
+
+#include "helpers.h"
+
+namespace astar {
+
+namespace tests {
+
+TEST(RangeQueryTest, WithinReturnsShortestCostsInIncreasingOrder) {
+
+    const auto graph = GraphFactory::make_vertex_graph(MeshFactory::make_grid(7));
+    const auto heuristics = HeuristicsFactory::make_euclidian();
+    const auto reach = find_within(graph, { 24 }, 2.5f);
+
+    ASSERT_EQ(reach.nodes.size(), reach.costs.size());
+    EXPECT_EQ(reach.nodes.front(), 24u);
+    EXPECT_FLOAT_EQ(reach.costs.front(), 0.f);
+    EXPECT_TRUE(std::is_sorted(reach.costs.begin(), reach.costs.end()));
+    for(std::size_t i=0; i < reach.nodes.size(); ++i) {
+        EXPECT_LE(reach.costs[i], 2.5f);
+        const auto path = find_best_path(graph, heuristics, { 24, reach.nodes[i] }, true);
+        EXPECT_NEAR(reach.costs[i], length(path), 1e-5f);
+    }
+    // every node left out is farther than the bound
+    for(std::size_t node=0; node < graph.positions.size(); ++node) {
+        if(std::find(reach.nodes.begin(), reach.nodes.end(), node) != reach.nodes.end()) continue;
+        EXPECT_GT(length(find_best_path(graph, heuristics, { 24, node }, true)), 2.5f);
+    }
+    EXPECT_EQ(find_within(graph, { 24 }, 1.f).nodes.size(), 5u);
+
+}
+
+TEST(RangeQueryTest, NearestStopsAtRequestedTargets) {
+
+    const auto graph = GraphFactory::make_vertex_graph(MeshFactory::make_grid(5));
+
+    const auto corner = find_nearest(graph, { 6 }, std::vector<std::size_t>{ 0, 24 });
+    EXPECT_EQ(corner.nodes, (std::vector<std::uint32_t>{ 0 }));
+    EXPECT_NEAR(corner.costs.front(), std::sqrt(2.f), 1e-6f);
+
+    const auto both = find_nearest(graph, { 6 }, std::vector<std::size_t>{ 24, 0 }, 2);
+    EXPECT_EQ(both.nodes, (std::vector<std::uint32_t>{ 0, 24 }));
+    EXPECT_TRUE(find_nearest(graph, { 6 }, std::vector<std::size_t>{ 24 }, 1, 2.f).nodes.empty());
+
+    const auto east = find_nearest(graph, { 10 }, [&graph](const std::size_t node) { return graph.positions[node][0] == 4.f; });
+    EXPECT_EQ(east.nodes, (std::vector<std::uint32_t>{ 14 }));
+    EXPECT_FLOAT_EQ(east.costs.front(), 4.f);
+
+    EXPECT_THROW(find_within(graph, { 25 }, 1.f), std::out_of_range);
+    EXPECT_THROW(find_nearest(graph, { 0 }, std::vector<std::size_t>{ 25 }), std::out_of_range);
+
+}
+
+TEST(RangeQueryTest, FaceGraphReachCoversTheIsland) {
+
+    const auto mesh = MeshFactory::make_pond();
+    const auto graph = GraphFactory::make_face_graph(mesh);
+    const auto components = ComponentsFactory::make(mesh);
+    const auto reach = find_within(graph, { 0 }, unbounded_cost);
+
+    const auto island = std::count(components.faces.begin(), components.faces.end(), components.faces[0]);
+    EXPECT_EQ(reach.nodes.size(), static_cast<std::size_t>(island));
+    for(const auto face : reach.nodes) EXPECT_EQ(components.faces[face], components.faces[0]);
+
+}
+
+TEST(RangeQueryTest, BatchesMatchSingleQueries) {
+
+    const auto graph = GraphFactory::make_vertex_graph(MeshFactory::make_grid(9));
+    const auto sources = std::vector<std::size_t>{ 0, 40, 80, 13, 40, 67, 8 };
+    const auto targets = std::vector<std::size_t>{ 4, 36, 44, 76 };
+
+    const auto within = batch_find_within(graph, sources, 3.f, 3);
+    const auto nearest = batch_find_nearest(graph, sources, targets, 2, unbounded_cost, 3);
+    const auto nearest_odd = batch_find_nearest(graph, sources, [](const std::size_t node) { return node % 2 == 1; }, 3, 5.f, 3);
+    ASSERT_EQ(within.size(), sources.size());
+    for(std::size_t i=0; i < sources.size(); ++i) {
+        const auto single = find_within(graph, { sources[i] }, 3.f);
+        EXPECT_EQ(within[i].nodes, single.nodes);
+        EXPECT_EQ(within[i].costs, single.costs);
+        EXPECT_EQ(nearest[i].nodes, find_nearest(graph, { sources[i] }, targets, 2).nodes);
+        EXPECT_EQ(nearest_odd[i].costs, find_nearest(graph, { sources[i] }, [](const std::size_t node) { return node % 2 == 1; }, 3, 5.f).costs);
+    }
+    EXPECT_TRUE(batch_find_within(graph, { }, 1.f).empty());
+
+}
+
+} // namespace astar::tests
+
+} // namespace astar
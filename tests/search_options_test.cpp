@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+
+#include "astar/search_options.h"
+
+namespace astar {
+
+namespace tests {
+
+TEST(SearchOptionsTest, OptimalSearchHasNoInflationNorBudget) {
+
+    const auto options = SearchOptionsFactory::make_optimal();
+
+    EXPECT_FLOAT_EQ(options.epsilon, 1.f);
+    EXPECT_FALSE(options.time_budget.has_value());
+
+}
+
+TEST(SearchOptionsTest, WeightedSearchClampsEpsilonToOne) {
+
+    EXPECT_FLOAT_EQ(SearchOptionsFactory::make_weighted(1.2f).epsilon, 1.2f);
+    EXPECT_FLOAT_EQ(SearchOptionsFactory::make_weighted(0.5f).epsilon, 1.f);
+
+}
+
+TEST(SearchOptionsTest, AnytimeSearchKeepsBudgetAndStep) {
+
+    const auto options = SearchOptionsFactory::make_anytime(2.5f, std::chrono::milliseconds{ 3 }, 0.25f);
+
+    EXPECT_FLOAT_EQ(options.epsilon, 2.5f);
+    EXPECT_FLOAT_EQ(options.epsilon_step, 0.25f);
+    ASSERT_TRUE(options.time_budget.has_value());
+    EXPECT_EQ(*options.time_budget, std::chrono::microseconds{ 3000 });
+
+}
+
+} // namespace astar::tests
+
+} // namespace astar
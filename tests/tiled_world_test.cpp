@@ -0,0 +1,157 @@
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "astar/heuristics.h"
+#include "astar/tiled_world.h"
+
+namespace astar {
+
+namespace tests {
+
+namespace {
+
+constexpr auto columns = std::size_t{ 9 };
+constexpr auto rows = std::size_t{ 3 };
+
+// World of (columns x rows) vertices on a unit grid, cut into two-cell wide tiles along x.
+Tile make_tile(const std::size_t tile) {
+
+    if(tile > 3) throw std::out_of_range{ "no such tile" };
+    auto result = Tile{ };
+    auto local = [&result](const std::size_t x, const std::size_t y) {
+        const auto world = y * columns + x;
+        const auto found = std::find(result.vertex_ids.begin(), result.vertex_ids.end(), world);
+        if(found != result.vertex_ids.end()) return static_cast<std::size_t>(std::distance(result.vertex_ids.begin(), found));
+        result.vertex_ids.push_back(world);
+        result.mesh.vertices.push_back(Vertex{ static_cast<float>(x), static_cast<float>(y), 0.f });
+        return result.vertex_ids.size() - 1u;
+    };
+    for(auto x = 2 * tile; x < 2 * tile + 2; ++x) {
+        for(std::size_t y=0; y + 1 < rows; ++y) {
+            const auto cell = 2 * (y * (columns - 1) + x);
+            result.mesh.faces.push_back(Face{ { local(x, y), local(x + 1, y), local(x + 1, y + 1) } });
+            result.mesh.faces.push_back(Face{ { local(x, y), local(x + 1, y + 1), local(x, y + 1) } });
+            result.face_ids.push_back(cell);
+            result.face_ids.push_back(cell + 1);
+        }
+    }
+    return result;
+
+}
+
+std::pair<Barycenter, Barycenter> face_ends(const std::size_t first, const std::size_t last) {
+
+    return { { first, { 1.f, 1.f, 1.f } }, { last, { 1.f, 1.f, 1.f } } };
+
+}
+
+} // namespace astar::tests::Anonymous
+
+TEST(TiledWorldTest, FindsVertexPathAcrossTiles) {
+
+    auto world = TiledWorld{ make_tile };
+    for(std::size_t tile=0; tile < 4; ++tile) world.load(tile);
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto p = find_best_path(world, h, std::pair<std::size_t, std::size_t>{ 0, 8 }, true);
+
+    ASSERT_EQ(p.steps.size(), 9u);
+    for(std::size_t x=0; x < columns; ++x) EXPECT_EQ(p.steps.at(x), x);
+    ASSERT_TRUE(p.vertices.has_value());
+    EXPECT_FLOAT_EQ(p.vertices->back()[0], 8.f);
+
+}
+
+TEST(TiledWorldTest, FindsFacePathAcrossTiles) {
+
+    auto world = TiledWorld{ make_tile };
+    for(std::size_t tile=0; tile < 4; ++tile) world.load(tile);
+    const auto h = HeuristicsFactory::make_euclidian();
+    const auto p = FindTiledPath{ world, h, false }(face_ends(0, 14));
+
+    ASSERT_FALSE(p.steps.empty());
+    EXPECT_EQ(p.steps.front(), 0u);
+    EXPECT_EQ(p.steps.back(), 14u);
+
+}
+
+TEST(TiledWorldTest, EvictedTileBreaksCrossingPath) {
+
+    auto world = TiledWorld{ make_tile };
+    for(std::size_t tile=0; tile < 4; ++tile) world.load(tile);
+    world.evict(1);
+    const auto h = HeuristicsFactory::make_euclidian();
+
+    EXPECT_FALSE(world.is_resident(1));
+    EXPECT_TRUE(find_best_path(world, h, std::pair<std::size_t, std::size_t>{ 0, 8 }).steps.empty());
+    EXPECT_TRUE(find_best_path(world, h, face_ends(0, 14)).steps.empty());
+    EXPECT_EQ(find_best_path(world, h, std::pair<std::size_t, std::size_t>{ 4, 8 }).steps.size(), 5u);
+
+}
+
+TEST(TiledWorldTest, StreamsTilesOnBackgroundThreadWhileQuerying) {
+
+    auto world = TiledWorld{ make_tile };
+    world.load(0);
+    const auto h = HeuristicsFactory::make_euclidian();
+    auto done = std::atomic<bool>{ false };
+    auto reader = std::thread{ [&] {
+        while(!done) {
+            const auto p = find_best_path(world, h, std::pair<std::size_t, std::size_t>{ 0, 2 });
+            EXPECT_EQ(p.steps.size(), 3u);
+        }
+    } };
+    for(std::size_t round=0; round < 20; ++round) {
+        for(std::size_t tile=1; tile < 4; ++tile) world.request_load(tile);
+        world.request_evict(2);
+    }
+    world.request_load(2);
+    world.wait_idle();
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(world.resident_tiles().size(), 4u);
+    EXPECT_EQ(find_best_path(world, h, std::pair<std::size_t, std::size_t>{ 0, 8 }).steps.size(), 9u);
+
+}
+
+TEST(TiledWorldTest, ReportsLoaderFailures) {
+
+    auto world = TiledWorld{ make_tile };
+    world.request_load(7);
+
+    EXPECT_THROW(world.wait_idle(), std::out_of_range);
+    EXPECT_TRUE(world.resident_tiles().empty());
+
+}
+
+TEST(TiledWorldTest, RejectsInconsistentTiles) {
+
+    const auto short_ids = [](const std::size_t tile) {
+        auto result = make_tile(tile);
+        result.vertex_ids.pop_back();
+        return result;
+    };
+    const auto stray_face = [](const std::size_t tile) {
+        auto result = make_tile(tile);
+        result.mesh.faces.push_back(Face{ { 0, 1, result.mesh.vertices.size() } });
+        result.face_ids.push_back(1000u);
+        return result;
+    };
+
+    auto shortened = TiledWorld{ short_ids };
+    shortened.request_load(0);
+    EXPECT_THROW(shortened.wait_idle(), std::invalid_argument);
+    EXPECT_TRUE(shortened.resident_tiles().empty());
+
+    auto stray = TiledWorld{ stray_face };
+    EXPECT_THROW(stray.load(1), std::invalid_argument);
+    EXPECT_TRUE(stray.resident_tiles().empty());
+
+}
+
+} // namespace astar::tests
+
+} // namespace astar
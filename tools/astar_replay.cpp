@@ -0,0 +1,185 @@
+// Replays a query log recorded with astar::QueryRecorder against a mesh and reports
+// latency percentiles, throughput and node expansions.
+//
+//   astar_replay <mesh.obj|mesh.ply> <queries.asql> [options]
+//     --threads N          concurrent queries (default 1)
+//     --search-threads N   threads per query, HDA* when > 1 (default 1)
+//     --epsilon E          weighted search inflation (default 1)
+//     --repeat R           replay the log R times (default 1)
+//     --per-query-graph    rebuild the adjacency on every query, as find_best_path(mesh, ...)
+//     --force              replay even if the log was recorded on another mesh
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "astar/astar.h"
+#include "astar/graph.h"
+#include "astar/heuristics.h"
+#include "astar/mesh_loader.h"
+#include "astar/query_log.h"
+#include "astar/search_options.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Settings {
+
+    std::string mesh_path;
+    std::string log_path;
+    std::size_t threads{ 1 };
+    std::size_t search_threads{ 1 };
+    float epsilon{ 1.f };
+    std::size_t repeat{ 1 };
+    bool per_query_graph{ false };
+    bool force{ false };
+
+};
+
+struct Sample {
+
+    double latency;
+    std::size_t expansions;
+    bool found;
+
+};
+
+Settings parse(const int argc, char** argv) {
+
+    if(argc < 3) throw std::invalid_argument{ "usage: astar_replay <mesh> <log> [--threads N] [--search-threads N] [--epsilon E] [--repeat R] [--per-query-graph] [--force]" };
+    auto settings = Settings{ argv[1], argv[2] };
+    for(auto i=3; i < argc; ++i) {
+        const auto flag = std::string{ argv[i] };
+        const auto value = [&]() {
+            if(i + 1 >= argc) throw std::invalid_argument{ "missing value after " + flag };
+            return std::string{ argv[++i] };
+        };
+        if(flag == "--threads") settings.threads = std::max<std::size_t>(std::stoul(value()), 1u);
+        else if(flag == "--search-threads") settings.search_threads = std::max<std::size_t>(std::stoul(value()), 1u);
+        else if(flag == "--epsilon") settings.epsilon = std::stof(value());
+        else if(flag == "--repeat") settings.repeat = std::max<std::size_t>(std::stoul(value()), 1u);
+        else if(flag == "--per-query-graph") settings.per_query_graph = true;
+        else if(flag == "--force") settings.force = true;
+        else throw std::invalid_argument{ "unknown option " + flag };
+    }
+    return settings;
+
+}
+
+// Answers one logged query: vertex pairs on the vertex graph, barycenter pairs on the face graph.
+struct Replay {
+
+    const astar::Mesh& mesh;
+    const astar::Graph& vertex_graph;
+    const astar::Graph& face_graph;
+    const astar::Heuristics& heuristics;
+    const astar::SearchOptions& options;
+    bool per_query_graph;
+
+    astar::Path operator()(const std::pair<std::size_t, std::size_t>& ends) const {
+        if(per_query_graph) return astar::find_best_path(mesh, heuristics, astar::Ends{ ends }, false, options);
+        return astar::find_best_path(vertex_graph, heuristics, ends, false, options);
+    }
+
+    astar::Path operator()(const std::pair<astar::Barycenter, astar::Barycenter>& ends) const {
+        if(per_query_graph) return astar::find_best_path(mesh, heuristics, astar::Ends{ ends }, false, options);
+        return astar::find_best_path(face_graph, heuristics, { ends.first.face, ends.second.face }, false, options);
+    }
+
+};
+
+double percentile(const std::vector<double>& sorted, const double rank) {
+
+    if(sorted.empty()) return 0.;
+    const auto index = static_cast<std::size_t>(rank * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+
+}
+
+int run(const Settings& settings) {
+
+    const auto mesh = astar::MeshLoader::load(settings.mesh_path);
+    const auto log = astar::QueryLogLoader::load(settings.log_path);
+    if(log.mesh_hash != astar::mesh_hash(mesh) && !settings.force) {
+        std::fprintf(stderr, "log was recorded on another mesh (use --force to replay anyway)\n");
+        return EXIT_FAILURE;
+    }
+
+    const auto heuristics = astar::HeuristicsFactory::make_euclidian();
+    auto options = settings.search_threads > 1 ? astar::SearchOptionsFactory::make_parallel(settings.search_threads, settings.epsilon)
+                                               : astar::SearchOptionsFactory::make_weighted(settings.epsilon);
+    const auto vertex_graph = settings.per_query_graph ? astar::Graph{ } : astar::GraphFactory::make_vertex_graph(mesh);
+    const auto face_graph = settings.per_query_graph ? astar::Graph{ } : astar::GraphFactory::make_face_graph(mesh);
+    const auto replay = Replay{ mesh, vertex_graph, face_graph, heuristics, options, settings.per_query_graph };
+
+    const auto total = log.queries.size() * settings.repeat;
+    auto samples = std::vector<Sample>(total);
+    auto next = std::atomic<std::size_t>{ 0 };
+    auto failure = std::exception_ptr{ };
+    auto failed = std::atomic<bool>{ false };
+    const auto work = [&]() {
+        try {
+            for(auto query = next.fetch_add(1); query < total && !failed.load(); query = next.fetch_add(1)) {
+                const auto start = Clock::now();
+                const auto path = std::visit(replay, log.queries[query % log.queries.size()]);
+                const auto latency = std::chrono::duration<double, std::micro>{ Clock::now() - start }.count();
+                samples[query] = Sample{ latency, path.expansions, !path.steps.empty() };
+            }
+        } catch(...) {
+            if(!failed.exchange(true)) failure = std::current_exception();
+        }
+    };
+
+    const auto start = Clock::now();
+    auto workers = std::vector<std::thread>{ };
+    for(std::size_t t=1; t < settings.threads; ++t) workers.emplace_back(work);
+    work();
+    for(auto& worker : workers) worker.join();
+    const auto elapsed = std::chrono::duration<double>{ Clock::now() - start }.count();
+    if(failure) std::rethrow_exception(failure);
+
+    auto latencies = std::vector<double>{ };
+    latencies.reserve(total);
+    auto expansions = std::size_t{ 0 };
+    auto found = std::size_t{ 0 };
+    for(const auto& sample : samples) {
+        latencies.push_back(sample.latency);
+        expansions += sample.expansions;
+        found += sample.found ? 1u : 0u;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    std::printf("queries      %zu (%zu found)\n", total, found);
+    std::printf("threads      %zu x %zu search\n", settings.threads, settings.search_threads);
+    std::printf("p50          %.1f us\n", percentile(latencies, 0.50));
+    std::printf("p99          %.1f us\n", percentile(latencies, 0.99));
+    std::printf("p999         %.1f us\n", percentile(latencies, 0.999));
+    std::printf("max          %.1f us\n", latencies.empty() ? 0. : latencies.back());
+    std::printf("throughput   %.1f queries/s\n", elapsed > 0. ? static_cast<double>(total) / elapsed : 0.);
+    std::printf("expansions   %zu\n", expansions);
+    return EXIT_SUCCESS;
+
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+
+    try {
+        return run(parse(argc, argv));
+    } catch(const std::exception& error) {
+        std::fprintf(stderr, "astar_replay: %s\n", error.what());
+        return EXIT_FAILURE;
+    }
+
+}